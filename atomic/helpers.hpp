@@ -36,7 +36,7 @@ constexpr auto WidestLockFreeIntegral()
   return result;
 }
 
-static auto uintmax_lockfree_bits = WidestLockFreeIntegral();
+inline constexpr auto uintmax_lockfree_bits = WidestLockFreeIntegral();
 using uintmax_lockfree_t = decltype(WidestLockFreeIntegral());
 
 template<unsigned bits>
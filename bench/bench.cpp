@@ -0,0 +1,547 @@
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include <machine/endian.hpp>
+#include <machine/fixed-point.hpp>
+#include <machine/fixed-point-array.hpp>
+#include <machine/fixed-point-math.hpp>
+#include <machine/fixed-point-linear.hpp>
+#include <machine/fixed-point-expression.hpp>
+#include <machine/checksum.hpp>
+#include <machine/flat-hash-map.hpp>
+#include <bit/helpers.hpp>
+#include <misc/text.hpp>
+#include <bench/harness.hpp>
+
+// Micro-benchmarks of the endian, bit and fixed-point primitives.
+//
+// usage: benchmark [filter]    (built by scripts/build-bench)
+//
+// Only benchmarks whose name contains [filter] are run.  Results are written to stdout as JSON,
+// progress to stderr, so the output can be redirected straight into a baseline file.
+
+using namespace culyun;
+
+namespace {
+
+constexpr std::size_t DataSize = 1024; // Power of two, so indices wrap with a mask
+
+std::vector<bench::Result> results;
+bench::Config config;
+std::string_view filter;
+
+template <typename Operation>
+void Run(std::string const & name, Operation && operation)
+{
+  if (name.find(filter) == std::string::npos) return;
+
+  std::fprintf(stderr, "%s\n", name.c_str());
+  results.push_back(bench::Measure(name, config, operation));
+}
+
+template <typename T>
+std::vector<T> RandomValues(uint64_t const seed)
+{
+  std::mt19937_64 generator(seed);
+  std::vector<T> values(DataSize);
+
+  for (T & value : values) {
+    value = static_cast<T>(generator());
+  }
+
+  return values;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename Native, typename Encoded>
+void benchEndian(std::string const & type)
+{
+  auto const values = RandomValues<Native>(1);
+
+  {
+    std::vector<Native> natives(values.begin(), values.end());
+    std::size_t i = 0;
+    Native sum = 0;
+
+    Run(fmt::format("endian/{}/native/add", type), [&]() {
+      sum += natives[i++ & (DataSize - 1)];
+      bench::DoNotOptimize(sum);
+    });
+
+    Run(fmt::format("endian/{}/native/load-store", type), [&]() {
+      Native & value = natives[i++ & (DataSize - 1)];
+      value = value + 1;
+      bench::ClobberMemory();
+    });
+  }
+
+  {
+    std::vector<Encoded> encoded(values.begin(), values.end());
+    std::size_t i = 0;
+    Native sum = 0;
+
+    Run(fmt::format("endian/{}/other-endian/add", type), [&]() {
+      sum += encoded[i++ & (DataSize - 1)];
+      bench::DoNotOptimize(sum);
+    });
+
+    Run(fmt::format("endian/{}/other-endian/load-store", type), [&]() {
+      Encoded & value = encoded[i++ & (DataSize - 1)];
+      value = value + 1;
+      bench::ClobberMemory();
+    });
+
+    Run(fmt::format("endian/{}/other-endian/compound-add", type), [&]() {
+      encoded[i++ & (DataSize - 1)] += 3;
+      bench::ClobberMemory();
+    });
+
+    Run(fmt::format("endian/{}/other-endian/and", type), [&]() {
+      Encoded const result = encoded[i & (DataSize - 1)] & encoded[(i + 1) & (DataSize - 1)];
+      ++i;
+      bench::DoNotOptimize(result);
+    });
+
+    Run(fmt::format("endian/{}/other-endian/equal", type), [&]() {
+      bool const equal = encoded[i & (DataSize - 1)] == encoded[(i + 7) & (DataSize - 1)];
+      ++i;
+      bench::DoNotOptimize(equal);
+    });
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchFindFreeBits()
+{
+  // Sparse enough that most searches succeed after skipping a few used runs
+  std::mt19937_64 generator(2);
+  std::vector<uint32_t> freeBitLists(DataSize);
+
+  for (uint32_t & list : freeBitLists) {
+    list = static_cast<uint32_t>(generator()) & static_cast<uint32_t>(generator());
+  }
+
+  for (unsigned const bits : {1U, 4U, 8U}) {
+    std::size_t i = 0;
+
+    Run(fmt::format("bit/FindFreeBits/uint32_t/{}", bits), [&]() {
+      int const index = bit::FindFreeBits(freeBitLists[i++ & (DataSize - 1)], bits);
+      bench::DoNotOptimize(index);
+    });
+
+    Run(fmt::format("bit/findFreeBits/uint32_t/{}", bits), [&]() {
+      int const index = bit::findFreeBits(freeBitLists[i++ & (DataSize - 1)], bits);
+      bench::DoNotOptimize(index);
+    });
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchFixedPrecision()
+{
+  using machine::FixedPrecision;
+
+  using Q8_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using UQ16_16 = FixedPrecision<{.isSigned = false, .bits = 32, .power = -16}>;
+
+  auto const raw16 = RandomValues<int16_t>(3);
+  auto const raw32 = RandomValues<uint32_t>(4);
+
+  std::vector<Q8_8> q8_8;
+  std::vector<UQ16_16> uq16_16;
+
+  for (std::size_t i = 0 ; i < DataSize ; ++i) {
+    q8_8.emplace_back(raw16[i] == 0 ? 1 : raw16[i]);
+    uq16_16.emplace_back(raw32[i] == 0 ? 1U : raw32[i]);
+  }
+
+  std::size_t i = 0;
+
+  Run("fixed-point/Q8.8/multiply", [&]() {
+    auto const product = q8_8[i & (DataSize - 1)] * q8_8[(i + 1) & (DataSize - 1)];
+    ++i;
+    bench::DoNotOptimize(product.data);
+  });
+
+  Run("fixed-point/Q8.8/divide", [&]() {
+    auto const quotient = q8_8[i & (DataSize - 1)] / q8_8[(i + 1) & (DataSize - 1)];
+    ++i;
+    bench::DoNotOptimize(quotient.data);
+  });
+
+  Run("fixed-point/UQ16.16/multiply", [&]() {
+    auto const product = uq16_16[i & (DataSize - 1)] * uq16_16[(i + 1) & (DataSize - 1)];
+    ++i;
+    bench::DoNotOptimize(product.data);
+  });
+
+  Run("fixed-point/UQ16.16/divide", [&]() {
+    auto const quotient = uq16_16[i & (DataSize - 1)] / uq16_16[(i + 1) & (DataSize - 1)];
+    ++i;
+    bench::DoNotOptimize(quotient.data);
+  });
+
+  Run("fixed-point/Q8.8/add/UQ16.16", [&]() {
+    auto const sum = q8_8[i & (DataSize - 1)] + uq16_16[(i + 1) & (DataSize - 1)];
+    ++i;
+    bench::DoNotOptimize(sum.data);
+  });
+
+  Run("fixed-point/Q8.8/divide/by-constant", [&]() {
+    auto const quotient = machine::DivideBy<Q8_8(0x0180)>(q8_8[i++ & (DataSize - 1)]);
+    bench::DoNotOptimize(quotient.data);
+  });
+
+  Run("fixed-point/UQ16.16/divide/by-constant", [&]() {
+    auto const quotient = machine::DivideBy<UQ16_16(0x0003243FU)>(uq16_16[i++ & (DataSize - 1)]);
+    bench::DoNotOptimize(quotient.data);
+  });
+
+  {
+    std::vector<machine::ProductOf<Q8_8, Q8_8>> products(DataSize);
+
+    Run("fixed-point/Q8.8/multiply/array/1024", [&]() {
+      machine::Multiply(q8_8, q8_8, products);
+      bench::ClobberMemory();
+    });
+
+    Run("fixed-point/Q8.8/multiply-accumulate/array/1024", [&]() {
+      machine::MultiplyAccumulate(q8_8, q8_8, products);
+      bench::ClobberMemory();
+    });
+  }
+
+  {
+    using Q8_8S = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .overflow = machine::OverflowPolicy::Saturate}>;
+
+    std::vector<Q8_8S> saturating(q8_8.begin(), q8_8.end());
+    std::vector<machine::ProductOf<Q8_8S, Q8_8S>> products(DataSize);
+    Q8_8S sum(0);
+
+    Run("fixed-point/Q8.8/saturating-add", [&]() {
+      sum += saturating[i++ & (DataSize - 1)];
+      bench::DoNotOptimize(sum.data);
+    });
+
+    Run("fixed-point/Q8.8/saturating-multiply-accumulate/array/1024", [&]() {
+      machine::MultiplyAccumulate(saturating, saturating, products);
+      bench::ClobberMemory();
+    });
+  }
+
+  Run("fixed-point/Q8.8/to-float32", [&]() {
+    float const value = static_cast<Q8_8::Float32>(q8_8[i++ & (DataSize - 1)]);
+    bench::DoNotOptimize(value);
+  });
+
+  {
+    std::vector<float> floats(DataSize);
+    machine::ToFloat(q8_8, floats);
+
+    Run("fixed-point/Q8.8/from-float32", [&]() {
+      auto const value = Q8_8::FromFloat(floats[i++ & (DataSize - 1)]);
+      bench::DoNotOptimize(value.data);
+    });
+
+    Run("fixed-point/Q8.8/to-float32/array/1024", [&]() {
+      machine::ToFloat(q8_8, floats);
+      bench::ClobberMemory();
+    });
+
+    Run("fixed-point/Q8.8/from-float32/array/1024", [&]() {
+      machine::FromFloat(floats, q8_8);
+      bench::ClobberMemory();
+    });
+  }
+
+  // Elementary functions, against the float round trip they replace
+
+  using Unit = FixedPrecision<machine::UnitTraits>;
+
+  Run("fixed-point/Q8.8/sin", [&]() {
+    auto const value = machine::Sin(q8_8[i++ & (DataSize - 1)]);
+    bench::DoNotOptimize(value.data);
+  });
+
+  Run("fixed-point/Q8.8/sin/float32", [&]() {
+    auto const value = Unit::FromFloat(std::sin(static_cast<float>(q8_8[i++ & (DataSize - 1)])));
+    bench::DoNotOptimize(value.data);
+  });
+
+  Run("fixed-point/Q8.8/atan2/UQ16.16", [&]() {
+    auto const value = machine::Atan2(q8_8[i & (DataSize - 1)], uq16_16[i & (DataSize - 1)]);
+    ++i;
+    bench::DoNotOptimize(value.data);
+  });
+
+  Run("fixed-point/Q8.8/exp", [&]() {
+    auto const value = machine::Exp(q8_8[i++ & (DataSize - 1)]);
+    bench::DoNotOptimize(value.data);
+  });
+
+  Run("fixed-point/UQ16.16/log2", [&]() {
+    auto const value = machine::Log2(uq16_16[i++ & (DataSize - 1)]);
+    bench::DoNotOptimize(value.data);
+  });
+
+  Run("fixed-point/UQ16.16/sqrt", [&]() {
+    auto const value = machine::Sqrt(uq16_16[i++ & (DataSize - 1)]);
+    bench::DoNotOptimize(value.data);
+  });
+
+  {
+    std::vector<Unit> sines(DataSize);
+
+    Run("fixed-point/Q8.8/sin/array/1024", [&]() {
+      machine::Sin(q8_8, sines);
+      bench::ClobberMemory();
+    });
+  }
+
+  // A multiply-accumulate chain of UQ16.16 values, whose products exceed 63 bits: eagerly, each product and sum is
+  // rounded to its traits, while the fused expression rounds its exact value once
+
+  Run("fixed-point/UQ16.16/multiply-accumulate/3-terms", [&]() {
+    auto const a = uq16_16[i & (DataSize - 1)], b = uq16_16[(i + 1) & (DataSize - 1)], c = uq16_16[(i + 2) & (DataSize - 1)];
+    ++i;
+    auto const value = UQ16_16::FromFixed(a * b + b * c - a * c);
+    bench::DoNotOptimize(value.data);
+  });
+
+  Run("fixed-point/UQ16.16/multiply-accumulate/3-terms/fused", [&]() {
+    auto const a = uq16_16[i & (DataSize - 1)], b = uq16_16[(i + 1) & (DataSize - 1)], c = uq16_16[(i + 2) & (DataSize - 1)];
+    ++i;
+    UQ16_16 const value = machine::Fused(a) * b + machine::Fused(b) * c - machine::Fused(a) * c;
+    bench::DoNotOptimize(value.data);
+  });
+
+  // Products of 126 bits, held exactly in __int128, and of 192 bits, narrowed to 128 by word
+
+  {
+    using Q32_32 = FixedPrecision<{.isSigned = true, .bits = 63, .power = -32, .maxBits = 127}>;
+    using UQ32_32 = FixedPrecision<{.isSigned = false, .bits = 64, .power = -32, .maxBits = 128}>;
+    using UQ64_64 = FixedPrecision<{.isSigned = false, .bits = 128, .power = -64, .maxBits = 128}>;
+
+    std::vector<Q32_32> q32_32;
+    std::vector<UQ32_32> uq32_32;
+    std::vector<UQ64_64> uq64_64;
+
+    for (std::size_t j = 0 ; j < DataSize ; ++j) {
+      uint64_t const high = uq16_16[j].data, low = uq16_16[(j + 1) & (DataSize - 1)].data;
+      q32_32.emplace_back(static_cast<int64_t>(high << 31 | low));
+      uq32_32.emplace_back(high << 32 | low);
+      uq64_64.emplace_back(static_cast<unsigned __int128>(high << 32 | low) << 64 | (low << 32 | high));
+    }
+
+    Run("fixed-point/Q32.32/multiply/127-bits", [&]() {
+      auto const product = q32_32[i & (DataSize - 1)] * q32_32[(i + 1) & (DataSize - 1)];
+      ++i;
+      bench::DoNotOptimize(product.data);
+    });
+
+    Run("fixed-point/UQ64.64/multiply/UQ32.32", [&]() {
+      auto const product = uq64_64[i & (DataSize - 1)] * uq32_32[(i + 1) & (DataSize - 1)];
+      ++i;
+      bench::DoNotOptimize(product.data);
+    });
+  }
+
+  // Sums of products, in accumulators sized by the number of terms
+
+  {
+    std::array<Q8_8, 32> taps;
+    std::copy_n(q8_8.begin(), taps.size(), taps.begin());
+
+    std::vector<machine::AccumulatorOf<Q8_8, Q8_8, 32>> outputs(DataSize - taps.size() + 1);
+    std::vector<machine::AccumulatorOf<Q8_8, Q8_8, 16>> products(16 * 16);
+
+    Run("fixed-point/Q8.8/dot/array/1024", [&]() {
+      auto const sum = machine::Dot<DataSize>(q8_8, q8_8);
+      bench::DoNotOptimize(sum.data);
+    });
+
+    Run("fixed-point/Q8.8/fir/32-taps/array/1024", [&]() {
+      machine::Fir(taps, q8_8, outputs);
+      bench::ClobberMemory();
+    });
+
+    Run("fixed-point/Q8.8/gemm/16x16x16", [&]() {
+      machine::Gemm<16, 16, 16>(q8_8, std::span(q8_8).subspan(256), products);
+      bench::ClobberMemory();
+    });
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchChecksum()
+{
+  for (std::size_t const size : {std::size_t(20), std::size_t(1500), std::size_t(9000)}) {
+    std::vector<std::byte> packet(size);
+    auto const values = RandomValues<uint8_t>(5);
+
+    for (std::size_t i = 0 ; i < size ; ++i) {
+      packet[i] = static_cast<std::byte>(values[i & (DataSize - 1)]);
+    }
+
+    Run(fmt::format("checksum/internet/{}", size), [&]() {
+      uint16_t const sum = checksum::InternetChecksum(std::span<std::byte const>(packet));
+      bench::DoNotOptimize(sum);
+    });
+
+    Run(fmt::format("checksum/crc32c/{}", size), [&]() {
+      uint32_t const crc = checksum::Crc32c(std::span<std::byte const>(packet));
+      bench::DoNotOptimize(crc);
+    });
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchFlowLookup()
+{
+  // Lookups of big-endian addresses, as read from packet headers, in a table of 2048 flows
+  auto const addresses = RandomValues<uint32_t>(6);
+
+  std::vector<uint32be_t> keys(addresses.begin(), addresses.end());
+  std::unordered_map<uint32_t, uint32_t> unorderedMap;
+  hash::FlatHashMap<uint32be_t, uint32_t> flatMap;
+
+  for (uint32_t const address : RandomValues<uint32_t>(7)) {
+    unorderedMap[address] = address;
+    flatMap[address] = address;
+  }
+
+  for (std::size_t k = 0 ; k < DataSize ; ++k) {
+    unorderedMap[addresses[k]] = addresses[k];
+    flatMap[keys[k]] = addresses[k];
+  }
+
+  std::size_t i = 0;
+
+  Run("hash/std::unordered_map/uint32be_t/find", [&]() {
+    auto const found = unorderedMap.find(keys[i++ & (DataSize - 1)].getNativeValue());
+    bench::DoNotOptimize(found->second);
+  });
+
+  Run("hash/FlatHashMap/uint32be_t/find", [&]() {
+    uint32_t const * const found = flatMap.find(keys[i++ & (DataSize - 1)]);
+    bench::DoNotOptimize(*found);
+  });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void benchHex()
+{
+  std::vector<std::byte> packet(1500);
+  auto const values = RandomValues<uint8_t>(8);
+
+  for (std::size_t i = 0 ; i < packet.size() ; ++i) {
+    packet[i] = static_cast<std::byte>(values[i & (DataSize - 1)]);
+  }
+
+  std::vector<char> output(text::HexdumpSize(packet.size()));
+
+  Run("text/toHexInto/1500", [&]() {
+    char * const end = text::toHexInto(output.data(), std::span<std::byte const>(packet));
+    bench::DoNotOptimize(end);
+    bench::ClobberMemory();
+  });
+
+  Run("text/hexdumpInto/1500", [&]() {
+    char * const end = text::hexdumpInto(output.data(), packet);
+    bench::DoNotOptimize(end);
+    bench::ClobberMemory();
+  });
+
+  std::size_t i = 0;
+
+  Run("text/toHex/uint32_t", [&]() {
+    std::string const hex = text::toHex(static_cast<uint32_t>(values[i++ & (DataSize - 1)]));
+    bench::DoNotOptimize(hex.data());
+  });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename StorageType>
+void benchAccessor(std::string const & type)
+{
+  using Delta = bit::Delta<typename bit::AtomicAccessor<StorageType>::ValueType>;
+
+  bit::AtomicAccessor<StorageType> atomicAccessor(0);
+  bit::TrivialAccessor<StorageType> trivialAccessor(0);
+
+  // Accessed through the interface, as the free bit lists do
+  typename bit::Accessor<StorageType>::Interface * const accessors[] = { &trivialAccessor, &atomicAccessor };
+  std::string_view const names[] = { "TrivialAccessor", "AtomicAccessor" };
+
+  for (std::size_t a = 0 ; a < 2 ; ++a) {
+    auto * const accessor = accessors[a];
+
+    Run(fmt::format("accessor/{}/{}/get", names[a], type), [&]() {
+      auto const value = accessor->get();
+      bench::DoNotOptimize(value);
+    });
+
+    Run(fmt::format("accessor/{}/{}/set", names[a], type), [&]() {
+      accessor->set(accessor->get() + 1);
+    });
+
+    Run(fmt::format("accessor/{}/{}/trySet/success", names[a], type), [&]() {
+      auto const current = accessor->get();
+      bool const success = accessor->trySet(Delta{current, current + 1});
+      bench::DoNotOptimize(success);
+    });
+
+    Run(fmt::format("accessor/{}/{}/trySet/failure", names[a], type), [&]() {
+      auto const current = accessor->get();
+      bool const success = accessor->trySet(Delta{current + 1, current});
+      bench::DoNotOptimize(success);
+    });
+  }
+}
+
+} // namespace
+
+int main(int const argc, char const * const * const argv)
+{
+  if (argc > 1) {
+    filter = argv[1];
+  }
+
+  benchEndian<uint16_t, uint16oe_t>("uint16");
+  benchEndian<uint32_t, uint32oe_t>("uint32");
+  benchEndian<uint64_t, uint64oe_t>("uint64");
+
+  benchFindFreeBits();
+
+  benchFixedPrecision();
+
+  benchChecksum();
+
+  benchFlowLookup();
+
+  benchHex();
+
+  benchAccessor<uint32_t>("uint32_t");
+  benchAccessor<uint64_t>("uint64_t");
+
+  std::fputs(bench::ToJson(results, config).c_str(), stdout);
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+// A minimal micro-benchmark harness.
+//
+// Each benchmark is a callable performing one operation.  It is run [warmup] times untimed,
+// then [samples] batches of [iterations] calls are timed, giving a cost per operation per batch.
+// Batches outside the Tukey fences (1.5 x IQR beyond the quartiles) are rejected as interrupted
+// or migrated runs, and the statistics are calculated over the remainder.
+//
+// Timing uses the TSC fenced with lfence on x86, so the counted region is not reordered around the
+// reads, and falls back to steady_clock nanoseconds elsewhere.  NB. The TSC ticks at a constant
+// reference rate, so pin the CPU frequency (or at least disable turbo) for comparable runs.
+
+namespace culyun::bench {
+
+// Prevents the compiler from discarding a value, or from assuming memory is unchanged
+
+template <typename T>
+inline void DoNotOptimize(T const & value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename T>
+inline void DoNotOptimize(T & value)
+{
+  asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+inline void ClobberMemory()
+{
+  asm volatile("" : : : "memory");
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+constexpr std::string_view TimeUnit = "cycles";
+
+inline uint64_t Now()
+{
+  _mm_lfence();
+  uint64_t const ticks = __rdtsc();
+  _mm_lfence();
+  return ticks;
+}
+
+#else
+
+constexpr std::string_view TimeUnit = "ns";
+
+inline uint64_t Now()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#endif
+
+struct Config
+{
+  std::size_t warmup = 1000;
+  std::size_t samples = 101;
+  std::size_t iterations = 1000;
+};
+
+struct Result
+{
+  std::string name;
+  std::size_t samples = 0;  // Batches timed
+  std::size_t rejected = 0; // Batches rejected as outliers
+  double min = 0.0;         // All statistics are per operation
+  double median = 0.0;
+  double mean = 0.0;
+  double stddev = 0.0;
+};
+
+template <typename Operation>
+Result Measure(std::string name, Config const & config, Operation && operation)
+{
+  for (std::size_t i = 0 ; i < config.warmup ; ++i) {
+    operation();
+  }
+
+  // Cost of an empty timed region, subtracted from every batch
+  uint64_t overhead = UINT64_MAX;
+
+  for (std::size_t i = 0 ; i < 16 ; ++i) {
+    uint64_t const start = Now();
+    uint64_t const stop = Now();
+    overhead = std::min(overhead, stop - start);
+  }
+
+  std::vector<double> costs;
+  costs.reserve(config.samples);
+
+  for (std::size_t sample = 0 ; sample < config.samples ; ++sample) {
+    uint64_t const start = Now();
+
+    for (std::size_t i = 0 ; i < config.iterations ; ++i) {
+      operation();
+    }
+
+    uint64_t const stop = Now();
+    uint64_t const elapsed = stop - start > overhead ? stop - start - overhead : 0;
+
+    costs.push_back(static_cast<double>(elapsed) / static_cast<double>(config.iterations));
+  }
+
+  std::sort(costs.begin(), costs.end());
+
+  auto const quantile = [&](double const q) {
+    double const position = q * static_cast<double>(costs.size() - 1);
+    std::size_t const lower = static_cast<std::size_t>(position);
+    std::size_t const upper = std::min(lower + 1, costs.size() - 1);
+    return costs[lower] + (position - static_cast<double>(lower)) * (costs[upper] - costs[lower]);
+  };
+
+  double const q1 = quantile(0.25);
+  double const q3 = quantile(0.75);
+  double const fence = 1.5 * (q3 - q1);
+
+  auto const first = std::lower_bound(costs.begin(), costs.end(), q1 - fence);
+  auto const last = std::upper_bound(costs.begin(), costs.end(), q3 + fence);
+
+  Result result;
+  result.name = std::move(name);
+  result.samples = costs.size();
+  result.rejected = costs.size() - static_cast<std::size_t>(last - first);
+  result.min = costs.front();
+  result.median = quantile(0.5);
+
+  double sum = 0.0;
+  for (auto cost = first ; cost != last ; ++cost) sum += *cost;
+  result.mean = sum / static_cast<double>(last - first);
+
+  double squares = 0.0;
+  for (auto cost = first ; cost != last ; ++cost) squares += (*cost - result.mean) * (*cost - result.mean);
+  result.stddev = std::sqrt(squares / static_cast<double>(last - first));
+
+  return result;
+}
+
+// Results are written as a single JSON document, for diffing against a stored baseline
+
+inline std::string ToJson(std::vector<Result> const & results, Config const & config)
+{
+  std::string json = fmt::format("{{\n  \"unit\": \"{}\",\n  \"warmup\": {},\n  \"samples\": {},\n  \"iterations\": {},\n  \"benchmarks\": [",
+                                 TimeUnit, config.warmup, config.samples, config.iterations);
+
+  for (std::size_t i = 0 ; i < results.size() ; ++i) {
+    Result const & result = results[i];
+
+    json += fmt::format("{}\n    {{ \"name\": \"{}\", \"min\": {:.3f}, \"median\": {:.3f}, \"mean\": {:.3f}, \"stddev\": {:.3f}, \"samples\": {}, \"rejected\": {} }}",
+                        i == 0 ? "" : ",", result.name, result.min, result.median, result.mean, result.stddev, result.samples, result.rejected);
+  }
+
+  json += "\n  ]\n}\n";
+  return json;
+}
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "bit/helpers.hpp"
+
+// Build time bit level layouts for protocol header words.
+//
+// Positions are given MSB-first, as drawn in protocol diagrams: offset 0 is the most significant bit of the word.
+// The word may be a native unsigned integral, or any wire type with getNativeValue() / setNativeValue(),
+// e.g. uint32be_t, OtherEndian<uint16_t>, or PackedEndian<uint64_t, std::endian::big>.
+//
+// For example, the first word of an IPv4 header:
+//
+//   using Ipv4Word0 = bit::BitLayout<uint32be_t, 4, 4, 6, 2, 16>;
+//   auto const version = Ipv4Word0::Field<0>::Get(header.word0);
+//   Ipv4Word0::Field<4>::Set(header.word0, totalLength);
+//
+// Get / Set are branch-free: one (possible) byte swap, a mask and a shift.
+// Extract pulls one field out of an array of headers at a time, 8 words per AVX2 iteration for 32-bit words.
+
+namespace culyun::bit {
+
+namespace detail {
+
+template <typename Word>
+constexpr auto NativeWordOf(Word const & word)
+{
+  if constexpr (std::is_integral_v<Word>) {
+    return static_cast<std::make_unsigned_t<Word>>(word);
+  } else {
+    return static_cast<std::make_unsigned_t<decltype(word.getNativeValue())>>(word.getNativeValue());
+  }
+}
+
+// Whether the in-memory representation of Word is byte reversed relative to native
+
+template <typename Word>
+constexpr bool IsByteReversed()
+{
+  if constexpr (std::is_integral_v<Word>) {
+    return false;
+  } else if constexpr (requires { Word::Order; }) {
+    return Word::Order != std::endian::native;
+  } else {
+    return true; // OtherEndian
+  }
+}
+
+} // namespace detail
+
+template <typename Word, unsigned msbOffset, unsigned width>
+requires std::is_trivially_copyable_v<Word> && (sizeof(Word) == sizeof(detail::NativeWordOf(std::declval<Word>()))) &&
+         (width > 0) && (msbOffset + width <= CHAR_BIT * sizeof(detail::NativeWordOf(std::declval<Word>())))
+struct BitField
+{
+  using WordType = Word;
+  using Native = decltype(detail::NativeWordOf(std::declval<Word>()));
+  using Value = decltype(IntegralLeast<width>());
+
+  static constexpr unsigned Bits = CHAR_BIT * sizeof(Native);
+  static constexpr unsigned Offset = msbOffset;
+  static constexpr unsigned Width = width;
+  static constexpr unsigned Shift = Bits - msbOffset - width;
+  static constexpr Native Mask = static_cast<Native>((width == Bits ? ~Native(0) : static_cast<Native>((Native(1) << width) - 1)) << Shift);
+
+  static constexpr Value Get(Word const & word) {
+    return static_cast<Value>((detail::NativeWordOf(word) & Mask) >> Shift);
+  }
+
+  // Values wider than the field are truncated to the field
+  static constexpr void Set(Word & word, Value const value) {
+    Native const native = static_cast<Native>((detail::NativeWordOf(word) & ~Mask) | ((static_cast<Native>(value) << Shift) & Mask));
+
+    if constexpr (std::is_integral_v<Word>) {
+      word = static_cast<Word>(native);
+    } else {
+      word.setNativeValue(native);
+    }
+  }
+};
+
+// Consecutive fields of the given widths, packed MSB-first from the top of Word
+
+template <typename Word, unsigned... widths>
+requires (sizeof...(widths) > 0)
+struct BitLayout
+{
+private:
+  static constexpr std::array<unsigned, sizeof...(widths)> Widths = { widths... };
+
+  static constexpr unsigned OffsetOf(std::size_t const index) {
+    unsigned offset = 0;
+    for (std::size_t i = 0 ; i < index ; ++i) offset += Widths[i];
+    return offset;
+  }
+
+public:
+  static constexpr std::size_t FieldCount = sizeof...(widths);
+  static constexpr unsigned UsedBits = (widths + ...);
+
+  template <std::size_t index>
+  requires (index < FieldCount)
+  using Field = BitField<Word, OffsetOf(index), Widths[index]>;
+};
+
+namespace detail {
+
+template <typename Field>
+void ExtractStrided(std::byte const * const first, std::size_t const stride, std::size_t const count, typename Field::Value * const values)
+{
+  using Word = typename Field::WordType;
+
+  std::size_t i = 0;
+
+#if defined(__AVX2__)
+  if constexpr (sizeof(typename Field::Native) == 4) {
+    if (stride <= (std::size_t(INT32_MAX) / 8)) {
+      __m256i const reverse = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                               3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+      __m256i const mask = _mm256_set1_epi32(static_cast<int>(Field::Mask >> Field::Shift));
+      __m256i const indices = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+
+      alignas(32) uint32_t lanes[8];
+
+      for ( ; i + 8 <= count ; i += 8) {
+        std::byte const * const base = first + i * stride;
+
+        __m256i words = stride == sizeof(Word)
+                            ? _mm256_loadu_si256(reinterpret_cast<__m256i const *>(base))
+                            : _mm256_i32gather_epi32(reinterpret_cast<int const *>(base), indices, 1);
+
+        if constexpr (IsByteReversed<Word>()) {
+          words = _mm256_shuffle_epi8(words, reverse);
+        }
+
+        words = _mm256_and_si256(_mm256_srli_epi32(words, Field::Shift), mask);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), words);
+
+        for (unsigned lane = 0 ; lane < 8 ; ++lane) {
+          values[i + lane] = static_cast<typename Field::Value>(lanes[lane]);
+        }
+      }
+    }
+  }
+#endif
+
+  for ( ; i < count ; ++i) {
+    Word word;
+    std::memcpy(&word, first + i * stride, sizeof(Word));
+    values[i] = Field::Get(word);
+  }
+}
+
+} // namespace detail
+
+// Extracts Field from each of a contiguous array of words
+
+template <typename Field>
+void Extract(std::span<typename Field::WordType const> const words, std::span<typename Field::Value> const values)
+{
+  assert(values.size() >= words.size());
+
+  detail::ExtractStrided<Field>(reinterpret_cast<std::byte const *>(words.data()), sizeof(typename Field::WordType), words.size(), values.data());
+}
+
+// Extracts Field from the given word of each of an array of headers
+
+template <typename Field, typename Header>
+void Extract(std::span<Header const> const headers, typename Field::WordType Header::* const word, std::span<typename Field::Value> const values)
+{
+  assert(values.size() >= headers.size());
+
+  if (headers.empty()) return;
+
+  detail::ExtractStrided<Field>(reinterpret_cast<std::byte const *>(&(headers[0].*word)), sizeof(Header), headers.size(), values.data());
+}
+
+}
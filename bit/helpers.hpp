@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <cassert>
+#include <concepts>
 #include <cstdint>
 #include <climits>
 #include <type_traits>
 
 #include "build_time/helpers.hpp"
+#include "atomic/helpers.hpp"
 
 namespace culyun::bit {
 
@@ -132,7 +136,7 @@ int findFreeBits(uint32_t freeBitList, unsigned const bits)
 
     static_assert(sizeof(unsigned) == sizeof(uint32_t));
 
-    unsigned const freeBits = freeBitList == 0 ? 0 : __builtin_clz(freeBitList);
+    unsigned const freeBits = freeBitList == 0 ? 32 : __builtin_clz(freeBitList);
 
     if (freeBits >= bits) {
       result = freeBitListIdx; return result;
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace culyun::io {
+
+// MappedRecordReader streams a file of fixed-layout records straight out of the page cache.
+//
+// The file is mmap'ed read-only and advised MADV_SEQUENTIAL, so the kernel reads ahead aggressively and drops pages behind.
+// Records are handed out as references into the mapping (zero-copy), so Record is expected to be declared with
+// wire typed fields, e.g. uint32be_t / uint64be_t / PackedEndian, which decode on access.
+//
+// Any trailing bytes that do not form a whole record are ignored (see trailingBytes()).
+
+template <typename Record>
+requires std::is_trivially_copyable_v<Record>
+class MappedRecordReader
+{
+public:
+
+  // Distance ahead of the current record to prefetch while iterating one record at a time
+  static constexpr std::size_t PrefetchBytes = 16 * 64;
+
+private:
+  int fd = -1;
+  std::byte const * mapping = nullptr;
+  std::size_t mappingSize = 0;
+  std::size_t recordCount = 0;
+  std::size_t position = 0;
+
+  static std::size_t PageSize() {
+    static std::size_t const pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return pageSize;
+  }
+
+  Record const * recordAt(std::size_t const index) const {
+    return reinterpret_cast<Record const *>(mapping + index * sizeof(Record));
+  }
+
+  // Ask the kernel to start reading [first, last) records in, ahead of their use
+  void willNeed(std::size_t const first, std::size_t const last) const {
+    if (first >= last) return;
+
+    std::size_t const begin = (first * sizeof(Record)) & ~(PageSize() - 1);
+    std::size_t const end = std::min(last * sizeof(Record), mappingSize);
+
+    ::madvise(const_cast<std::byte *>(mapping) + begin, end - begin, MADV_WILLNEED);
+  }
+
+public:
+  MappedRecordReader() = default;
+
+  ~MappedRecordReader() { close(); }
+
+  // MappedRecordReader is non-copyable, but moveable
+  MappedRecordReader(MappedRecordReader const &) = delete;
+  MappedRecordReader & operator=(MappedRecordReader const &) = delete;
+
+  MappedRecordReader(MappedRecordReader && other) noexcept { *this = std::move(other); }
+
+  MappedRecordReader & operator=(MappedRecordReader && other) noexcept {
+    if (this != &other) {
+      close();
+      fd = std::exchange(other.fd, -1);
+      mapping = std::exchange(other.mapping, nullptr);
+      mappingSize = std::exchange(other.mappingSize, 0);
+      recordCount = std::exchange(other.recordCount, 0);
+      position = std::exchange(other.position, 0);
+    }
+
+    return *this;
+  }
+
+  // open maps the file at path.
+  // returns:
+  //  (a) 0 if successful, or
+  //  (b) -errno if the file could not be opened, inspected, or mapped
+
+  int open(char const * const path) {
+    close();
+
+    fd = ::open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+      return -errno;
+    }
+
+    struct stat status;
+
+    if (::fstat(fd, &status) != 0) {
+      int const result = -errno;
+      close();
+      return result;
+    }
+
+    mappingSize = static_cast<std::size_t>(status.st_size);
+    recordCount = mappingSize / sizeof(Record);
+
+    if (mappingSize == 0) {
+      return 0; // Nothing to map, and mmap rejects zero length mappings
+    }
+
+    void * const address = ::mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (address == MAP_FAILED) {
+      int const result = -errno;
+      close();
+      return result;
+    }
+
+    mapping = static_cast<std::byte const *>(address);
+    ::madvise(address, mappingSize, MADV_SEQUENTIAL);
+
+    return 0;
+  }
+
+  void close() {
+    if (mapping != nullptr) {
+      ::munmap(const_cast<std::byte *>(mapping), mappingSize);
+    }
+
+    if (fd >= 0) {
+      ::close(fd);
+    }
+
+    fd = -1;
+    mapping = nullptr;
+    mappingSize = 0;
+    recordCount = 0;
+    position = 0;
+  }
+
+  bool isOpen() const { return fd >= 0; }
+
+  std::size_t size() const { return recordCount; }
+
+  std::size_t remaining() const { return recordCount - position; }
+
+  std::size_t trailingBytes() const { return mappingSize - recordCount * sizeof(Record); }
+
+  void rewind() { position = 0; }
+
+  // All records, for random access or range-for
+
+  std::span<Record const> records() const {
+    return {recordAt(0), recordCount};
+  }
+
+  // Record at a time iteration.  Returns nullptr once every record has been read.
+
+  Record const * next() {
+    if (position >= recordCount) return nullptr;
+
+    std::byte const * const current = mapping + position * sizeof(Record);
+
+    if (position * sizeof(Record) + PrefetchBytes < mappingSize) {
+      __builtin_prefetch(current + PrefetchBytes, 0, 0);
+    }
+
+    ++position;
+    return reinterpret_cast<Record const *>(current);
+  }
+
+  // Batched iteration, handing out up to maxRecords contiguous records for vectorized conversion.
+  // The following batch is requested from the kernel while this one is being processed.
+  // Returns an empty span once every record has been read.
+
+  std::span<Record const> nextBatch(std::size_t const maxRecords) {
+    std::size_t const count = std::min(maxRecords, remaining());
+    std::span<Record const> const batch = {recordAt(position), count};
+
+    position += count;
+    willNeed(position, std::min(position + maxRecords, recordCount));
+
+    return batch;
+  }
+};
+
+}
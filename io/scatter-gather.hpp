@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace culyun::io {
+
+// MessageBuilder assembles a message as a list of iovecs for writev / sendmsg, rather than in one contiguous buffer.
+//
+// Headers (typically structs of uint16be_t / uint32be_t / OtherEndian fields) are constructed in place in a small
+// inline header arena.  Payloads are referenced where they are, so large payloads are sent without being copied;
+// payloads of up to CopyThreshold bytes are copied into the arena instead, where they coalesce with the headers
+// around them into a single iovec.  Consecutive arena allocations share an iovec whenever they are contiguous.
+//
+// A builder is intended to be reused: reset() releases the arena and the iovecs for the next message.
+// Referenced payloads must remain valid until the message has been written.
+//
+//   io::MessageBuilder<> message;
+//   auto * const header = message.emplace<FrameHeader>();
+//   header->length = payload.size();
+//   message.append(payload);
+//   message.writeTo(socket);
+
+template <std::size_t arenaCapacity = 512, std::size_t maxSegments = 16, std::size_t copyThreshold = 64>
+class MessageBuilder
+{
+public:
+  static constexpr std::size_t ArenaCapacity = arenaCapacity;
+  static constexpr std::size_t MaxSegments = maxSegments;
+  static constexpr std::size_t CopyThreshold = copyThreshold;
+
+private:
+  alignas(std::max_align_t) std::byte arena[arenaCapacity];
+  std::size_t arenaUsed = 0;
+
+  std::array<iovec, maxSegments> segments;
+  std::size_t segmentCount = 0;
+  std::size_t totalBytes = 0;
+
+  // Whether the last segment ends exactly at the arena's allocation point, so the next allocation can extend it
+  bool lastSegmentInArena() const {
+    if (segmentCount == 0) return false;
+    iovec const & last = segments[segmentCount - 1];
+    return static_cast<std::byte *>(last.iov_base) + last.iov_len == arena + arenaUsed;
+  }
+
+  // Reserves [bytes] of the arena at [alignment], and adds them to the iovecs
+  void * allocate(std::size_t const bytes, std::size_t const alignment) {
+    std::size_t const offset = (arenaUsed + alignment - 1) & ~(alignment - 1);
+
+    if (offset + bytes > arenaCapacity) return nullptr;
+
+    bool const extend = offset == arenaUsed && lastSegmentInArena();
+
+    if (!extend && segmentCount == maxSegments) return nullptr;
+
+    std::byte * const address = arena + offset;
+
+    if (extend) {
+      segments[segmentCount - 1].iov_len += bytes;
+    } else {
+      segments[segmentCount++] = { address, bytes };
+    }
+
+    arenaUsed = offset + bytes;
+    totalBytes += bytes;
+
+    return address;
+  }
+
+public:
+  MessageBuilder() = default;
+
+  // The iovecs refer into the builder's own arena, so it is neither copyable nor moveable
+  MessageBuilder(MessageBuilder const &) = delete;
+  MessageBuilder & operator=(MessageBuilder const &) = delete;
+
+  void reset() {
+    arenaUsed = 0;
+    segmentCount = 0;
+    totalBytes = 0;
+  }
+
+  // Constructs a Header in the arena, and appends it to the message.
+  // Returns nullptr if the arena, or the iovecs, are exhausted.
+
+  template <typename Header, typename... Args>
+  requires std::is_trivially_copyable_v<Header>
+  Header * emplace(Args &&... args) {
+    void * const address = allocate(sizeof(Header), alignof(Header));
+    if (address == nullptr) return nullptr;
+    return ::new (address) Header{std::forward<Args>(args)...};
+  }
+
+  // append adds bytes to the message, by reference if larger than CopyThreshold, otherwise by copy.
+  // returns:
+  //  (a) 0 if successful, or
+  //  (b) -ENOBUFS if the arena, or the iovecs, are exhausted
+
+  int append(std::span<std::byte const> const payload) {
+    if (payload.empty()) return 0;
+
+    if (payload.size() <= copyThreshold) {
+      void * const address = allocate(payload.size(), 1);
+      if (address == nullptr) return -ENOBUFS;
+      std::memcpy(address, payload.data(), payload.size());
+      return 0;
+    }
+
+    if (segmentCount == maxSegments) return -ENOBUFS;
+
+    segments[segmentCount++] = { const_cast<std::byte *>(payload.data()), payload.size() };
+    totalBytes += payload.size();
+
+    return 0;
+  }
+
+  template <typename T>
+  requires std::is_trivially_copyable_v<T>
+  int append(std::span<T const> const payload) {
+    return append(std::as_bytes(payload));
+  }
+
+  std::span<iovec const> iovecs() const { return {segments.data(), segmentCount}; }
+
+  std::size_t size() const { return totalBytes; }
+
+  std::size_t arenaBytes() const { return arenaUsed; }
+
+  // Local stand-in for writev, e.g. for tests, or for transports that need a contiguous buffer.
+  // Returns the number of bytes copied, which is less than size() if output is too small.
+
+  std::size_t gatherTo(std::span<std::byte> const output) const {
+    std::size_t copied = 0;
+
+    for (iovec const & segment : iovecs()) {
+      std::size_t const bytes = std::min(segment.iov_len, output.size() - copied);
+      std::memcpy(output.data() + copied, segment.iov_base, bytes);
+      copied += bytes;
+      if (bytes < segment.iov_len) break;
+    }
+
+    return copied;
+  }
+
+  // writeTo writes the whole message to fd, resuming after partial writes.
+  // sendTo does the same with sendmsg, passing flags (e.g. MSG_NOSIGNAL).
+  // returns:
+  //  (a) the number of bytes written (== size()) if successful, or
+  //  (b) -errno if a write fails
+
+  ssize_t writeTo(int const fd) const {
+    return transmit([fd](iovec * const vector, std::size_t const count) {
+      return ::writev(fd, vector, static_cast<int>(count));
+    });
+  }
+
+  ssize_t sendTo(int const fd, int const flags = 0) const {
+    return transmit([fd, flags](iovec * const vector, std::size_t const count) {
+      msghdr message = {};
+      message.msg_iov = vector;
+      message.msg_iovlen = count;
+      return ::sendmsg(fd, &message, flags);
+    });
+  }
+
+private:
+  template <typename Write>
+  ssize_t transmit(Write const & write) const {
+    // A partial write advances through a working copy of the iovecs
+    std::array<iovec, maxSegments> pending;
+    std::copy(segments.begin(), segments.begin() + segmentCount, pending.begin());
+
+    iovec * first = pending.data();
+    std::size_t count = segmentCount;
+    std::size_t written = 0;
+
+    while (written < totalBytes) {
+      ssize_t const result = write(first, count);
+
+      if (result < 0) {
+        if (errno == EINTR) continue;
+        return -errno;
+      }
+
+      if (result == 0) return -EIO; // No progress
+
+      written += static_cast<std::size_t>(result);
+
+      for (std::size_t remaining = static_cast<std::size_t>(result) ; remaining > 0 ; ) {
+        if (remaining >= first->iov_len) {
+          remaining -= first->iov_len;
+          ++first;
+          --count;
+        } else {
+          first->iov_base = static_cast<std::byte *>(first->iov_base) + remaining;
+          first->iov_len -= remaining;
+          remaining = 0;
+        }
+      }
+    }
+
+    return static_cast<ssize_t>(written);
+  }
+};
+
+}
@@ -0,0 +1,305 @@
+#include <string>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include <boost/ut.hpp>
+
+#include <machine/endian.hpp>
+#include <io/mapped-records.hpp>
+#include <io/scatter-gather.hpp>
+#include <misc/text.hpp>
+#include <misc/ansi-codes.hpp>
+#include <misc/ut-helpers.hpp>
+
+using namespace ansi_code;
+using namespace culyun;
+
+namespace ut = boost::ut;
+using namespace boost::ut::bdd;
+
+namespace {
+
+struct CaptureRecord
+{
+  uint32be_t id;
+  uint32be_t length;
+  uint64be_t timestamp;
+};
+
+// Writes [count] records, plus [trailingBytes] bytes of junk, to a fresh temporary file
+
+std::string writeCaptureFile(std::size_t const count, std::size_t const trailingBytes = 0)
+{
+  char path[] = "/tmp/test-io-XXXXXX";
+  int const fd = ::mkstemp(path);
+
+  std::vector<CaptureRecord> records(count);
+
+  for (std::size_t i = 0 ; i < count ; ++i) {
+    records[i].id = static_cast<uint32_t>(i);
+    records[i].length = static_cast<uint32_t>(i * 3);
+    records[i].timestamp = 0x0102030400000000ULL + i;
+  }
+
+  std::vector<uint8_t> const junk(trailingBytes, 0xA5);
+
+  [[maybe_unused]] auto const recordBytes = ::write(fd, records.data(), records.size() * sizeof(CaptureRecord));
+  [[maybe_unused]] auto const junkBytes = ::write(fd, junk.data(), junk.size());
+  ::close(fd);
+
+  return path;
+}
+
+} // anonymous namespace
+
+void testMappedRecordReader()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-IO-0001: io::MappedRecordReader streams fixed-layout wire records from a mapped file\n", reset));
+
+  given("a capture file of big-endian records with a partial record at the end") = [&]
+  {
+    constexpr std::size_t RecordCount = 10000;
+    std::string const path = writeCaptureFile(RecordCount, 5);
+
+    io::MappedRecordReader<CaptureRecord> reader;
+    int const result = reader.open(path.c_str());
+
+    then("the file should map, and the partial record should be ignored") = [&]
+    {
+      ut::expect(result == 0);
+      ut::expect(reader.size() == RecordCount);
+      ut::expect(reader.trailingBytes() == 5U);
+    };
+
+    when("records are read one at a time") = [&]
+    {
+      std::size_t count = 0;
+      bool decoded = true;
+
+      while (CaptureRecord const * const record = reader.next()) {
+        decoded = decoded && record->id == count && record->length == count * 3 && record->timestamp == 0x0102030400000000ULL + count;
+        ++count;
+      }
+
+      then("every record should be visited in order, decoding in place") = [&]
+      {
+        ut::expect(count == RecordCount);
+        ut::expect(decoded);
+        ut::expect(reader.next() == nullptr);
+      };
+    };
+
+    when("records are read in batches") = [&]
+    {
+      reader.rewind();
+
+      std::size_t count = 0;
+      std::size_t batches = 0;
+      bool decoded = true;
+
+      for (auto batch = reader.nextBatch(4096) ; !batch.empty() ; batch = reader.nextBatch(4096)) {
+        for (auto const & record : batch) {
+          decoded = decoded && record.id == count;
+          ++count;
+        }
+
+        ++batches;
+      }
+
+      then("the batches should cover every record exactly once") = [&]
+      {
+        ut::expect(count == RecordCount);
+        ut::expect(batches == 3U);
+        ut::expect(decoded);
+      };
+    };
+
+    reader.close();
+    ::unlink(path.c_str());
+  };
+
+  given("an empty file, and a missing file") = [&]
+  {
+    std::string const path = writeCaptureFile(0);
+
+    io::MappedRecordReader<CaptureRecord> empty;
+    io::MappedRecordReader<CaptureRecord> missing;
+
+    int const emptyResult = empty.open(path.c_str());
+    int const missingResult = missing.open("/nonexistent/capture.bin");
+
+    then("the empty file should open with no records, and the missing file should report -ENOENT") = [&]
+    {
+      ut::expect(emptyResult == 0);
+      ut::expect(empty.size() == 0U);
+      ut::expect(empty.next() == nullptr);
+      ut::expect(empty.nextBatch(16).empty());
+      ut::expect(missingResult == -ENOENT);
+      ut::expect(!missing.isOpen());
+    };
+
+    ::unlink(path.c_str());
+  };
+}
+
+void testMessageBuilder()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-IO-0002: io::MessageBuilder gathers wire headers and referenced payloads into iovecs\n", reset));
+
+  struct FrameHeader
+  {
+    uint16be_t type;
+    uint16be_t flags;
+    uint32be_t length;
+  };
+
+  struct FrameTrailer
+  {
+    uint32be_t sequence;
+  };
+
+  // The expected encoding, built contiguously
+  auto const contiguous = [](std::span<std::byte const> const payload, uint32_t const sequence) {
+    std::vector<std::byte> bytes;
+    auto const put = [&bytes](uint64_t const value, int const width) {
+      for (int i = width - 1 ; i >= 0 ; --i) bytes.push_back(static_cast<std::byte>(value >> (8 * i)));
+    };
+
+    put(0x0102, 2);
+    put(0x8000, 2);
+    put(payload.size(), 4);
+    bytes.insert(bytes.end(), payload.begin(), payload.end());
+    put(sequence, 4);
+
+    return bytes;
+  };
+
+  io::MessageBuilder<> message;
+
+  auto const build = [&message](std::span<std::byte const> const payload, uint32_t const sequence) {
+    message.reset();
+
+    FrameHeader * const header = message.emplace<FrameHeader>();
+    header->type = 0x0102;
+    header->flags = 0x8000;
+    header->length = static_cast<uint32_t>(payload.size());
+
+    int const result = message.append(payload);
+
+    FrameTrailer * const trailer = message.emplace<FrameTrailer>();
+    trailer->sequence = sequence;
+
+    return result;
+  };
+
+  given("a frame with a large payload") = [&]
+  {
+    std::vector<std::byte> payload(100000);
+    for (std::size_t i = 0 ; i < payload.size() ; ++i) payload[i] = static_cast<std::byte>(i * 13);
+
+    int const result = build(payload, 77);
+
+    then("the payload should be referenced in place, between the header and trailer") = [&]
+    {
+      ut::expect(result == 0);
+      ut::expect(message.iovecs().size() == 3U);
+      ut::expect(message.iovecs()[1].iov_base == payload.data());
+      ut::expect(message.size() == sizeof(FrameHeader) + payload.size() + sizeof(FrameTrailer));
+      ut::expect(message.arenaBytes() == sizeof(FrameHeader) + sizeof(FrameTrailer));
+    };
+
+    when("it is gathered locally") = [&]
+    {
+      std::vector<std::byte> gathered(message.size());
+      std::size_t const copied = message.gatherTo(gathered);
+
+      then("it should match the contiguous encoding") = [&]
+      {
+        ut::expect(copied == message.size());
+        ut::expect(gathered == contiguous(payload, 77));
+      };
+    };
+
+    when("it is written to a pipe, with partial writes, and read back") = [&]
+    {
+      int pipeFds[2];
+      ut::expect(::pipe(pipeFds) == 0);
+
+      std::vector<std::byte> received;
+      std::thread reader([&]() {
+        std::byte buffer[4096];
+        for (ssize_t bytes ; (bytes = ::read(pipeFds[0], buffer, sizeof(buffer))) > 0 ; ) {
+          received.insert(received.end(), buffer, buffer + bytes);
+        }
+      });
+
+      ssize_t const written = message.writeTo(pipeFds[1]);
+      ::close(pipeFds[1]);
+      reader.join();
+      ::close(pipeFds[0]);
+
+      then("every byte should arrive, in order") = [&]
+      {
+        ut::expect(written == static_cast<ssize_t>(message.size()));
+        ut::expect(received == contiguous(payload, 77));
+      };
+    };
+  };
+
+  given("a frame with a small payload") = [&]
+  {
+    std::array<std::byte, 6> const payload = { std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}, std::byte{5}, std::byte{6} };
+
+    build(payload, 5);
+
+    std::vector<std::byte> gathered(message.size());
+    message.gatherTo(gathered);
+
+    then("the payload should be copied, and coalesce with the header and aligned trailer where contiguous") = [&]
+    {
+      ut::expect(message.iovecs().size() == 2U); // Header + payload, then the 4-byte aligned trailer
+      ut::expect(gathered == contiguous(payload, 5));
+    };
+  };
+
+  given("a builder whose arena is exhausted") = [&]
+  {
+    io::MessageBuilder<16, 4> small;
+
+    then("further headers and copied payloads should be refused") = [&]
+    {
+      ut::expect(small.emplace<FrameHeader>() != nullptr);
+      ut::expect(small.emplace<FrameHeader>() != nullptr);
+      ut::expect(small.emplace<FrameHeader>() == nullptr);
+      ut::expect(small.append(std::span<std::byte const>(reinterpret_cast<std::byte const *>("x"), 1)) == -ENOBUFS);
+      ut::expect(small.size() == 2 * sizeof(FrameHeader));
+    };
+  };
+}
+
+int main()
+{
+  testMappedRecordReader();
+  testMessageBuilder();
+
+  return 0;
+}
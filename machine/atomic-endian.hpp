@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <type_traits>
+
+#include "endian.hpp"
+#include "atomic/helpers.hpp"
+
+// AtomicOtherEndian is the lock-free atomic counterpart of OtherEndian.
+//
+// The value is held byte swapped in a std::atomic, so a counter or sequence number in a shared memory segment
+// can be updated atomically while other processes read it in wire order (e.g. as a uint32be_t).
+//
+// - load / store / exchange / compare_exchange convert at the boundary, and are single atomic operations.
+// - fetch_add / fetch_sub are CAS loops over the swapped representation, since carries propagate the wrong way.
+// - fetch_and / fetch_or / fetch_xor commute with the byte swap, so operate directly on the swapped representation.
+//
+// The storage type is chosen with atomic::LockFreeIntegralLeast, so a platform without a lock-free atomic
+// of the required width fails the build rather than silently falling back to a lock.
+
+namespace culyun { namespace endian {
+
+template<typename StorageType>
+requires std::is_integral_v<StorageType> && (sizeof(StorageType) == 2 || sizeof(StorageType) == 4 || sizeof(StorageType) == 8)
+class AtomicOtherEndian
+{
+public:
+  using ValueType = StorageType;
+  using Encoding = decltype(atomic::LockFreeIntegralLeast<CHAR_BIT * sizeof(StorageType)>());
+
+  static_assert(sizeof(Encoding) == sizeof(StorageType),
+                "\n\n\33[1;31mError: No lock-free atomic integral of exactly the width of StorageType!\33[0m\n\n");
+
+  static constexpr bool is_always_lock_free = std::atomic<Encoding>::is_always_lock_free;
+
+private:
+  std::atomic<Encoding> value = {0};
+
+  static Encoding Encode(StorageType const native) { return ReverseBytes(static_cast<Encoding>(native)); }
+  static StorageType Decode(Encoding const encoded) { return static_cast<StorageType>(ReverseBytes(encoded)); }
+
+  // Replaces the value with operation(native), returning the previous native value
+
+  template <typename Operation>
+  StorageType update(Operation const & operation, std::memory_order const order) {
+    Encoding current = value.load(std::memory_order_relaxed);
+
+    while (!value.compare_exchange_weak(current, Encode(operation(Decode(current))), order, std::memory_order_relaxed)) {}
+
+    return Decode(current);
+  }
+
+public:
+  AtomicOtherEndian() = default;
+
+  AtomicOtherEndian(StorageType const native) : value(Encode(native)) {}
+
+  // AtomicOtherEndian is neither copyable nor moveable, like std::atomic
+  AtomicOtherEndian(AtomicOtherEndian const &) = delete;
+  AtomicOtherEndian & operator=(AtomicOtherEndian const &) = delete;
+
+  bool is_lock_free() const { return value.is_lock_free(); }
+
+  // Load / Store
+
+  StorageType load(std::memory_order const order = std::memory_order_seq_cst) const {
+    return Decode(value.load(order));
+  }
+
+  void store(StorageType const native, std::memory_order const order = std::memory_order_seq_cst) {
+    value.store(Encode(native), order);
+  }
+
+  // The wire (byte swapped) representation, e.g. to copy into an outgoing message without a swap
+
+  OtherEndian<StorageType> loadEncoded(std::memory_order const order = std::memory_order_seq_cst) const {
+    OtherEndian<StorageType> result;
+    result.setEncodedValue(static_cast<StorageType>(value.load(order)));
+    return result;
+  }
+
+  StorageType exchange(StorageType const native, std::memory_order const order = std::memory_order_seq_cst) {
+    return Decode(value.exchange(Encode(native), order));
+  }
+
+  // Compare Exchange.  On failure expected is updated with the current (native) value.
+
+  bool compare_exchange_weak(StorageType & expected, StorageType const desired,
+                             std::memory_order const success, std::memory_order const failure) {
+    Encoding encodedExpected = Encode(expected);
+    bool const exchanged = value.compare_exchange_weak(encodedExpected, Encode(desired), success, failure);
+    if (!exchanged) expected = Decode(encodedExpected);
+    return exchanged;
+  }
+
+  bool compare_exchange_strong(StorageType & expected, StorageType const desired,
+                               std::memory_order const success, std::memory_order const failure) {
+    Encoding encodedExpected = Encode(expected);
+    bool const exchanged = value.compare_exchange_strong(encodedExpected, Encode(desired), success, failure);
+    if (!exchanged) expected = Decode(encodedExpected);
+    return exchanged;
+  }
+
+  bool compare_exchange_weak(StorageType & expected, StorageType const desired, std::memory_order const order = std::memory_order_seq_cst) {
+    return compare_exchange_weak(expected, desired, order, FailureOrder(order));
+  }
+
+  bool compare_exchange_strong(StorageType & expected, StorageType const desired, std::memory_order const order = std::memory_order_seq_cst) {
+    return compare_exchange_strong(expected, desired, order, FailureOrder(order));
+  }
+
+  // Arithmetic, with the wrap around semantics of std::atomic
+
+  StorageType fetch_add(StorageType const operand, std::memory_order const order = std::memory_order_seq_cst) {
+    return update([operand](StorageType const native) { return Wrap(native, operand); }, order);
+  }
+
+  StorageType fetch_sub(StorageType const operand, std::memory_order const order = std::memory_order_seq_cst) {
+    return update([operand](StorageType const native) { return static_cast<StorageType>(static_cast<Encoding>(native) - static_cast<Encoding>(operand)); }, order);
+  }
+
+  // Bitwise operations need no CAS loop
+
+  StorageType fetch_and(StorageType const operand, std::memory_order const order = std::memory_order_seq_cst) {
+    return Decode(value.fetch_and(Encode(operand), order));
+  }
+
+  StorageType fetch_or(StorageType const operand, std::memory_order const order = std::memory_order_seq_cst) {
+    return Decode(value.fetch_or(Encode(operand), order));
+  }
+
+  StorageType fetch_xor(StorageType const operand, std::memory_order const order = std::memory_order_seq_cst) {
+    return Decode(value.fetch_xor(Encode(operand), order));
+  }
+
+  // Operators, with the std::atomic convention of returning values rather than references
+
+  operator StorageType() const { return load(); }
+
+  StorageType operator=(StorageType const native) { store(native); return native; }
+
+  StorageType operator++() { return Wrap(fetch_add(1), 1); }
+  StorageType operator--() { return Wrap(fetch_sub(1), static_cast<StorageType>(-1)); }
+  StorageType operator++(int) { return fetch_add(1); }
+  StorageType operator--(int) { return fetch_sub(1); }
+
+  StorageType operator+=(StorageType const rhs) { return Wrap(fetch_add(rhs), rhs); }
+  StorageType operator-=(StorageType const rhs) { return Wrap(fetch_sub(rhs), static_cast<StorageType>(Encoding(0) - static_cast<Encoding>(rhs))); }
+  StorageType operator&=(StorageType const rhs) { return static_cast<StorageType>(fetch_and(rhs) & rhs); }
+  StorageType operator|=(StorageType const rhs) { return static_cast<StorageType>(fetch_or(rhs) | rhs); }
+  StorageType operator^=(StorageType const rhs) { return static_cast<StorageType>(fetch_xor(rhs) ^ rhs); }
+
+private:
+  // Two's complement sum, without the undefined behaviour of signed overflow
+  static constexpr StorageType Wrap(StorageType const lhs, StorageType const rhs) {
+    return static_cast<StorageType>(static_cast<Encoding>(lhs) + static_cast<Encoding>(rhs));
+  }
+
+  static constexpr std::memory_order FailureOrder(std::memory_order const order) {
+    if (order == std::memory_order_acq_rel) return std::memory_order_acquire;
+    if (order == std::memory_order_release) return std::memory_order_relaxed;
+    return order;
+  }
+};
+
+}} // namespace culyun::endian
+
+namespace {
+
+// Typedef be, le, and oe atomic equivalents to the fixed-width integral types.
+// Native orders use std::atomic directly, which has the same interface.
+
+using atomic_uint16be_t = std::conditional_t<std::endian::native == std::endian::big, std::atomic<uint16_t>, culyun::endian::AtomicOtherEndian<uint16_t>>;
+using atomic_int16be_t = std::conditional_t<std::endian::native == std::endian::big, std::atomic<int16_t>, culyun::endian::AtomicOtherEndian<int16_t>>;
+
+using atomic_uint32be_t = std::conditional_t<std::endian::native == std::endian::big, std::atomic<uint32_t>, culyun::endian::AtomicOtherEndian<uint32_t>>;
+using atomic_int32be_t = std::conditional_t<std::endian::native == std::endian::big, std::atomic<int32_t>, culyun::endian::AtomicOtherEndian<int32_t>>;
+
+using atomic_uint64be_t = std::conditional_t<std::endian::native == std::endian::big, std::atomic<uint64_t>, culyun::endian::AtomicOtherEndian<uint64_t>>;
+using atomic_int64be_t = std::conditional_t<std::endian::native == std::endian::big, std::atomic<int64_t>, culyun::endian::AtomicOtherEndian<int64_t>>;
+
+using atomic_uint16le_t = std::conditional_t<std::endian::native == std::endian::little, std::atomic<uint16_t>, culyun::endian::AtomicOtherEndian<uint16_t>>;
+using atomic_int16le_t = std::conditional_t<std::endian::native == std::endian::little, std::atomic<int16_t>, culyun::endian::AtomicOtherEndian<int16_t>>;
+
+using atomic_uint32le_t = std::conditional_t<std::endian::native == std::endian::little, std::atomic<uint32_t>, culyun::endian::AtomicOtherEndian<uint32_t>>;
+using atomic_int32le_t = std::conditional_t<std::endian::native == std::endian::little, std::atomic<int32_t>, culyun::endian::AtomicOtherEndian<int32_t>>;
+
+using atomic_uint64le_t = std::conditional_t<std::endian::native == std::endian::little, std::atomic<uint64_t>, culyun::endian::AtomicOtherEndian<uint64_t>>;
+using atomic_int64le_t = std::conditional_t<std::endian::native == std::endian::little, std::atomic<int64_t>, culyun::endian::AtomicOtherEndian<int64_t>>;
+
+using atomic_uint16oe_t = culyun::endian::AtomicOtherEndian<uint16_t>;
+using atomic_int16oe_t = culyun::endian::AtomicOtherEndian<int16_t>;
+
+using atomic_uint32oe_t = culyun::endian::AtomicOtherEndian<uint32_t>;
+using atomic_int32oe_t = culyun::endian::AtomicOtherEndian<int32_t>;
+
+using atomic_uint64oe_t = culyun::endian::AtomicOtherEndian<uint64_t>;
+using atomic_int64oe_t = culyun::endian::AtomicOtherEndian<int64_t>;
+
+}
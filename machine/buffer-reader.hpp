@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "varint.hpp"
+
+// BufferReader is a bounds checked cursor over an encoded message,
+// interleaving fixed width wire fields (uint32be_t, PackedEndian, WireStruct payloads, ...) with varints in a single pass.
+//
+// Each read returns false, and leaves the cursor where it was, if the buffer is exhausted or the encoding is malformed.
+
+namespace culyun::varint {
+
+class BufferReader
+{
+private:
+  std::span<std::byte const> buffer;
+  std::size_t position = 0;
+
+public:
+  explicit BufferReader(std::span<std::byte const> const buffer) : buffer(buffer) {}
+
+  std::size_t offset() const { return position; }
+
+  std::size_t remaining() const { return buffer.size() - position; }
+
+  bool empty() const { return remaining() == 0; }
+
+  std::span<std::byte const> unread() const { return buffer.subspan(position); }
+
+  bool skip(std::size_t const bytes) {
+    if (bytes > remaining()) return false;
+    position += bytes;
+    return true;
+  }
+
+  // Fixed width fields.
+  // WireType is typically an OtherEndian / PackedEndian / be / le typedef, which decodes on conversion.
+
+  template <typename WireType>
+  requires std::is_trivially_copyable_v<WireType>
+  bool read(WireType & value) {
+    if (sizeof(WireType) > remaining()) return false;
+    std::memcpy(&value, buffer.data() + position, sizeof(WireType));
+    position += sizeof(WireType);
+    return true;
+  }
+
+  // Raw bytes, returned as a view into the buffer
+  bool read(std::span<std::byte const> & bytes, std::size_t const length) {
+    if (length > remaining()) return false;
+    bytes = buffer.subspan(position, length);
+    position += length;
+    return true;
+  }
+
+  // Variable length fields
+
+  template <std::unsigned_integral Unsigned>
+  bool readVarint(Unsigned & value) {
+    std::size_t const length = DecodeLeb128(unread(), value);
+    position += length;
+    return length != 0;
+  }
+
+  template <std::signed_integral Signed>
+  bool readZigZag(Signed & value) {
+    std::make_unsigned_t<Signed> encoded;
+    if (!readVarint(encoded)) return false;
+    value = ZigZagDecode(encoded);
+    return true;
+  }
+
+  template <std::signed_integral Signed>
+  bool readSleb128(Signed & value) {
+    std::size_t const length = DecodeSleb128(unread(), value);
+    position += length;
+    return length != 0;
+  }
+
+  // Decodes up to values.size() consecutive varints with the bulk decoder.
+  // Returns the number decoded; the cursor advances past exactly those values.
+
+  template <std::unsigned_integral Unsigned>
+  std::size_t readVarints(std::span<Unsigned> const values) {
+    BulkDecodeResult const result = DecodeLeb128(unread(), values);
+    position += result.bytes;
+    return result.values;
+  }
+};
+
+}
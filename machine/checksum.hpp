@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE4_2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#endif
+
+#include "endian.hpp"
+
+// Checksums computed directly over encoded (wire order) buffers, e.g. headers built from uint16be_t / uint32be_t fields.
+//
+// Internet checksum (RFC 1071)
+//   The ones' complement sum is byte order independent up to a final byte swap, so the buffer is summed as
+//   native words, 32 bytes per AVX2 iteration (8 bytes per iteration otherwise), and swapped once at the end.
+//   UpdateChecksum applies RFC 1624 incremental updates when a single 16 / 32-bit field changes.
+//
+// CRC32C (Castagnoli)
+//   Uses the SSE4.2 crc32 instruction 8 bytes at a time when available, over three interleaved streams for long
+//   buffers, combined with a carry-less multiply (PCLMUL) or a GF(2) multiply.  Otherwise a byte-wise table.
+
+namespace culyun::checksum {
+
+///////////////////////////////////////////////////////////////////////////////
+// Internet checksum
+
+namespace detail {
+
+// Folds a ones' complement accumulator to 16 bits
+
+constexpr uint16_t Fold(uint64_t sum)
+{
+  sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+  sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+  sum = (sum & 0xFFFF) + (sum >> 16);
+  sum = (sum & 0xFFFF) + (sum >> 16);
+  return static_cast<uint16_t>(sum);
+}
+
+// Ones' complement sum of data as native 16-bit words, deferring the carries into a 64-bit accumulator
+
+inline uint64_t SumNative(std::byte const * data, std::size_t size)
+{
+  uint64_t sum = 0;
+
+#if defined(__AVX2__)
+  // Each block adds at most 2 x 0xFFFF to every 32-bit lane, so lanes are flushed well before they could overflow
+  constexpr std::size_t MaxBlocksPerFlush = 1 << 15;
+
+  __m256i const zero = _mm256_setzero_si256();
+
+  while (size >= 32) {
+    __m256i lanes = _mm256_setzero_si256();
+    std::size_t blocks = std::min(size / 32, MaxBlocksPerFlush);
+
+    size -= blocks * 32;
+
+    for ( ; blocks > 0 ; --blocks, data += 32) {
+      __m256i const words = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data));
+      lanes = _mm256_add_epi32(lanes, _mm256_unpacklo_epi16(words, zero));
+      lanes = _mm256_add_epi32(lanes, _mm256_unpackhi_epi16(words, zero));
+    }
+
+    // Horizontal sum of the 32-bit lanes into 64 bits
+    __m256i const wide = _mm256_add_epi64(_mm256_unpacklo_epi32(lanes, zero), _mm256_unpackhi_epi32(lanes, zero));
+    __m128i const half = _mm_add_epi64(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+    sum += static_cast<uint64_t>(_mm_cvtsi128_si64(half)) + static_cast<uint64_t>(_mm_extract_epi64(half, 1));
+  }
+#endif
+
+  // Summing 32-bit words is equivalent, after folding, to summing 16-bit words
+  for ( ; size >= 8 ; size -= 8, data += 8) {
+    uint32_t words[2];
+    std::memcpy(words, data, sizeof(words));
+    sum += uint64_t(words[0]) + words[1];
+  }
+
+  for ( ; size >= 2 ; size -= 2, data += 2) {
+    uint16_t word;
+    std::memcpy(&word, data, sizeof(word));
+    sum += word;
+  }
+
+  if (size == 1) {
+    // Pad the final byte with zero, as the least significant byte of a big-endian word
+    uint8_t const padded[2] = { std::to_integer<uint8_t>(*data), 0 };
+    uint16_t word;
+    std::memcpy(&word, padded, sizeof(word));
+    sum += word;
+  }
+
+  return sum;
+}
+
+} // namespace detail
+
+// Ones' complement sum of data as big-endian 16-bit words, folded to 16 bits and returned as a native value.
+// Sums of consecutive chunks may be chained through previous, provided every chunk but the last has an even size.
+
+inline uint16_t Sum(std::span<std::byte const> const data, uint16_t const previous = 0)
+{
+  uint16_t const sum = detail::Fold(detail::SumNative(data.data(), data.size()));
+
+  if constexpr (std::endian::native == std::endian::little) {
+    return detail::Fold(uint32_t(endian::ReverseBytes(sum)) + previous);
+  } else {
+    return detail::Fold(uint32_t(sum) + previous);
+  }
+}
+
+// The value to store in a header's checksum field, e.g. as a uint16be_t
+
+inline uint16_t InternetChecksum(std::span<std::byte const> const data, uint16_t const previous = 0)
+{
+  return static_cast<uint16_t>(~Sum(data, previous));
+}
+
+// Convenience overloads over arrays of wire words
+
+template <typename Word>
+requires std::is_trivially_copyable_v<Word> && (sizeof(Word) % 2 == 0)
+uint16_t Sum(std::span<Word const> const words, uint16_t const previous = 0)
+{
+  return Sum(std::as_bytes(words), previous);
+}
+
+template <typename Word>
+requires std::is_trivially_copyable_v<Word> && (sizeof(Word) % 2 == 0)
+uint16_t InternetChecksum(std::span<Word const> const words, uint16_t const previous = 0)
+{
+  return InternetChecksum(std::as_bytes(words), previous);
+}
+
+// Incremental update (RFC 1624, eqn. 3): HC' = ~(~HC + ~m + m')
+//
+// checksum is the native value of the checksum field; before / after are the native values of a 16-bit field.
+// The field must lie at an even offset within the checksummed data, as header fields do.
+
+constexpr uint16_t UpdateChecksum(uint16_t const checksum, uint16_t const before, uint16_t const after)
+{
+  return static_cast<uint16_t>(~detail::Fold(uint32_t(uint16_t(~checksum)) + uint16_t(~before) + after));
+}
+
+constexpr uint16_t UpdateChecksum(uint16_t const checksum, uint32_t const before, uint32_t const after)
+{
+  uint32_t const sum = uint32_t(uint16_t(~checksum))
+                     + uint16_t(~(before >> 16)) + uint16_t(~before)
+                     + uint16_t(after >> 16) + uint16_t(after);
+
+  return static_cast<uint16_t>(~detail::Fold(sum));
+}
+
+// Assigns value to a 16 or 32-bit wire field (e.g. uint16be_t, uint32be_u_t), and updates the header's
+// checksum field to match, without re-summing the header:
+//
+//   checksum::SetField(ip.checksum, ip.ttl_protocol, newTtlProtocol);
+
+template <typename ChecksumField, typename Field, typename Value>
+void SetField(ChecksumField & checksum, Field & field, Value const value)
+{
+  using Native = std::remove_cvref_t<decltype(endian::GetNativeValue(field))>;
+  static_assert((sizeof(Native) == 2 || sizeof(Native) == 4) && sizeof(Field) == sizeof(Native),
+                "\n\n\33[1;31mError: Incremental checksum updates support 16 and 32-bit fields only!\33[0m\n\n");
+
+  using Unsigned = std::make_unsigned_t<Native>;
+
+  auto const before = static_cast<Unsigned>(endian::GetNativeValue(field));
+  field = static_cast<Native>(value);
+  auto const after = static_cast<Unsigned>(endian::GetNativeValue(field));
+
+  checksum = UpdateChecksum(static_cast<uint16_t>(endian::GetNativeValue(checksum)), before, after);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// CRC32C
+
+namespace detail {
+
+constexpr uint32_t Crc32cPolynomial = 0x82F63B78; // Reflected 0x1EDC6F41
+
+constexpr std::array<uint32_t, 256> Crc32cTable = []() {
+  std::array<uint32_t, 256> table = {};
+
+  for (uint32_t i = 0 ; i < 256 ; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0 ; bit < 8 ; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? Crc32cPolynomial : 0);
+    }
+    table[i] = crc;
+  }
+
+  return table;
+}();
+
+// Polynomial arithmetic modulo the CRC32C polynomial, in the reflected representation (bit 31 is x^0)
+
+constexpr uint32_t PowerOfX(std::size_t exponent)
+{
+  uint32_t result = 0x80000000; // x^0
+
+  for ( ; exponent > 0 ; --exponent) {
+    result = (result >> 1) ^ ((result & 1) ? Crc32cPolynomial : 0);
+  }
+
+  return result;
+}
+
+constexpr uint32_t MultiplyModP(uint32_t const lhs, uint32_t rhs)
+{
+  uint32_t result = 0;
+
+  for (uint32_t mask = 0x80000000 ; mask != 0 ; mask >>= 1) {
+    if (lhs & mask) result ^= rhs;
+    rhs = (rhs >> 1) ^ ((rhs & 1) ? Crc32cPolynomial : 0);
+  }
+
+  return result;
+}
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+
+// The crc32 instruction has a latency of 3 cycles, but a throughput of 1 per cycle,
+// so long buffers are split into three interleaved streams whose CRCs are then combined.
+
+constexpr std::size_t StreamBytes = 256;
+
+// Advances a CRC register over [bytes] zero bytes, i.e. multiplies it by x^(8 x bytes) mod P
+
+template <std::size_t bytes>
+inline uint32_t ShiftCrc(uint32_t const crc)
+{
+#if defined(__PCLMUL__)
+  // The carry-less product is one power of x high, and crc32 of a 64-bit word multiplies by x^32 before reducing,
+  // so the constant is x^(8 x bytes - 33)
+  constexpr uint32_t Constant = PowerOfX(CHAR_BIT * bytes - 33);
+
+  __m128i const product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(crc)), _mm_cvtsi32_si128(static_cast<int>(Constant)), 0);
+  return static_cast<uint32_t>(_mm_crc32_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(product))));
+#else
+  return MultiplyModP(crc, PowerOfX(CHAR_BIT * bytes));
+#endif
+}
+
+#endif
+
+} // namespace detail
+
+// CRC32C of data.  CRCs of consecutive chunks may be chained through previous.
+
+inline uint32_t Crc32c(std::span<std::byte const> const data, uint32_t const previous = 0)
+{
+  uint32_t crc = ~previous;
+  std::byte const * bytes = data.data();
+  std::size_t size = data.size();
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+  auto const load = [](std::byte const * const address) {
+    uint64_t word;
+    std::memcpy(&word, address, sizeof(word));
+    return word;
+  };
+
+  for ( ; size >= 3 * detail::StreamBytes ; size -= 3 * detail::StreamBytes, bytes += 3 * detail::StreamBytes) {
+    uint64_t a = crc;
+    uint64_t b = 0;
+    uint64_t c = 0;
+
+    for (std::size_t offset = 0 ; offset < detail::StreamBytes ; offset += 8) {
+      a = _mm_crc32_u64(a, load(bytes + offset));
+      b = _mm_crc32_u64(b, load(bytes + detail::StreamBytes + offset));
+      c = _mm_crc32_u64(c, load(bytes + 2 * detail::StreamBytes + offset));
+    }
+
+    // The CRC register is linear: crc(A || B || C) = shift(crc(A), |B| + |C|) ^ shift(crc0(B), |C|) ^ crc0(C)
+    crc = detail::ShiftCrc<2 * detail::StreamBytes>(static_cast<uint32_t>(a))
+        ^ detail::ShiftCrc<detail::StreamBytes>(static_cast<uint32_t>(b))
+        ^ static_cast<uint32_t>(c);
+  }
+
+  uint64_t crc64 = crc;
+
+  for ( ; size >= 8 ; size -= 8, bytes += 8) {
+    crc64 = _mm_crc32_u64(crc64, load(bytes));
+  }
+
+  crc = static_cast<uint32_t>(crc64);
+
+  for ( ; size > 0 ; --size, ++bytes) {
+    crc = _mm_crc32_u8(crc, std::to_integer<uint8_t>(*bytes));
+  }
+#else
+  for ( ; size > 0 ; --size, ++bytes) {
+    crc = (crc >> 8) ^ detail::Crc32cTable[(crc ^ std::to_integer<uint8_t>(*bytes)) & 0xFF];
+  }
+#endif
+
+  return ~crc;
+}
+
+template <typename Word>
+requires std::is_trivially_copyable_v<Word>
+uint32_t Crc32c(std::span<Word const> const words, uint32_t const previous = 0)
+{
+  return Crc32c(std::as_bytes(words), previous);
+}
+
+}
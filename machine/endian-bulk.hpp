@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#if defined(__SSSE3__) || defined(__AVX2__) || defined(__AVX512BW__)
+#include <immintrin.h>
+#endif
+
+#include "endian.hpp"
+
+// Bulk conversion of OtherEndian spans.
+//
+// The kernels reverse the bytes of every [width]-byte element in a buffer using pshufb,
+// consuming 64 / 32 / 16 bytes per iteration when AVX-512BW / AVX2 / SSSE3 are enabled at build time.
+// Whatever the widest kernel leaves over falls through to the next narrower one, and finally to a scalar bswap loop.
+//
+// Instruction set selection is made at build time (e.g. -march=native), in keeping with OtherEndian itself.
+// Without any of the above the scalar loop does all the work.
+
+namespace culyun { namespace endian {
+
+namespace detail {
+
+// Shuffle control that reverses each [width]-byte element within a 16-byte lane.
+// pshufb shuffles within 128-bit lanes, so the same pattern is replicated for the wider registers.
+
+template <std::size_t width>
+constexpr std::array<int8_t, 16> ReverseShuffleLane()
+{
+  std::array<int8_t, 16> lane = {};
+
+  for (std::size_t i = 0 ; i < lane.size() ; ++i) {
+    lane[i] = static_cast<int8_t>((i / width) * width + (width - 1 - i % width));
+  }
+
+  return lane;
+}
+
+template <std::size_t width>
+void ReverseByteBlocksScalar(std::byte const * src, std::byte * dst, std::size_t const count)
+{
+  using Word = UnsignedOfWidth<width>;
+
+  for (std::size_t i = 0 ; i < count ; ++i) {
+    Word word;
+    std::memcpy(&word, src + i * width, width);
+    word = ReverseBytes(word);
+    std::memcpy(dst + i * width, &word, width);
+  }
+}
+
+// Reverses the byte order of [count] elements of [width] bytes.
+// src and dst must either be the same buffer (in place conversion) or not overlap at all.
+
+template <std::size_t width>
+requires (width == 2 || width == 4 || width == 8 || width == 16)
+void ReverseByteBlocks(std::byte const * src, std::byte * dst, std::size_t const count)
+{
+  std::size_t const bytes = count * width;
+  std::size_t offset = 0;
+
+  [[maybe_unused]] constexpr auto lane = ReverseShuffleLane<width>();
+
+#if defined(__AVX512BW__)
+  {
+    __m512i const shuffle = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<__m128i const *>(lane.data())));
+
+    for ( ; offset + 64 <= bytes ; offset += 64) {
+      __m512i const block = _mm512_loadu_si512(src + offset);
+      _mm512_storeu_si512(dst + offset, _mm512_shuffle_epi8(block, shuffle));
+    }
+  }
+#endif
+
+#if defined(__AVX2__)
+  {
+    __m256i const shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(lane.data())));
+
+    for ( ; offset + 32 <= bytes ; offset += 32) {
+      __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + offset));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + offset), _mm256_shuffle_epi8(block, shuffle));
+    }
+  }
+#endif
+
+#if defined(__SSSE3__)
+  {
+    __m128i const shuffle = _mm_loadu_si128(reinterpret_cast<__m128i const *>(lane.data()));
+
+    for ( ; offset + 16 <= bytes ; offset += 16) {
+      __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + offset));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset), _mm_shuffle_epi8(block, shuffle));
+    }
+  }
+#endif
+
+  ReverseByteBlocksScalar<width>(src + offset, dst + offset, (bytes - offset) / width);
+}
+
+} // namespace detail
+
+// OtherEndian<StorageType> must be a pure reinterpretation of its storage for the bulk kernels to apply
+
+template <typename StorageType>
+concept BulkConvertible =
+    EndianIntegral<StorageType> &&
+    sizeof(OtherEndian<StorageType>) == sizeof(StorageType) &&
+    std::is_trivially_copyable_v<OtherEndian<StorageType>>;
+
+// Decodes encoded into native.  native must be at least as long as encoded.
+
+template <typename StorageType>
+requires BulkConvertible<StorageType>
+void ConvertToNative(std::span<OtherEndian<StorageType> const> const encoded, std::span<StorageType> const native)
+{
+  assert(native.size() >= encoded.size());
+
+  detail::ReverseByteBlocks<sizeof(StorageType)>(reinterpret_cast<std::byte const *>(encoded.data()),
+                                                 reinterpret_cast<std::byte *>(native.data()),
+                                                 encoded.size());
+}
+
+// Encodes native into encoded.  encoded must be at least as long as native.
+
+template <typename StorageType>
+requires BulkConvertible<StorageType>
+void ConvertToEncoded(std::span<StorageType const> const native, std::span<OtherEndian<StorageType>> const encoded)
+{
+  assert(encoded.size() >= native.size());
+
+  detail::ReverseByteBlocks<sizeof(StorageType)>(reinterpret_cast<std::byte const *>(native.data()),
+                                                 reinterpret_cast<std::byte *>(encoded.data()),
+                                                 native.size());
+}
+
+// Native to native is a plain copy, mirroring GetNativeValue().
+// This keeps code written against the be / le typedefs portable to hosts where those typedefs are native integrals.
+
+template <typename StorageType>
+requires EndianIntegral<StorageType>
+void ConvertToNative(std::span<StorageType const> const native, std::span<StorageType> const destination)
+{
+  assert(destination.size() >= native.size());
+
+  if (native.data() != destination.data() && !native.empty()) {
+    std::memcpy(destination.data(), native.data(), native.size_bytes());
+  }
+}
+
+// In place conversion of a buffer of raw wire words, e.g. a receive buffer holding encoded uint32_t fields.
+// Applying it twice restores the original buffer, so it serves for both decoding and encoding.
+
+template <typename StorageType>
+requires EndianIntegral<StorageType>
+void ReverseBytesInPlace(std::span<StorageType> const values)
+{
+  auto * const bytes = reinterpret_cast<std::byte *>(values.data());
+  detail::ReverseByteBlocks<sizeof(StorageType)>(bytes, bytes, values.size());
+}
+
+}} // namespace culyun::endian
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "ieee754_types.hpp"
+#include "endian.hpp"
+#include "endian-bulk.hpp"
+
+// OtherEndianFloat is the IEEE 754 binary interchange counterpart of OtherEndian.
+//
+// The encoding is held as an unsigned integral of the same width, so loads and stores never pass
+// a byte-swapped (and possibly signalling NaN) bit pattern through a floating point register.
+// Arithmetic is performed natively via the implicit conversion to IEEE_754::_2008::Binary<width>.
+
+namespace culyun { namespace endian {
+
+template <int width>
+requires (width == 32 || width == 64)
+class OtherEndianFloat
+{
+public:
+  using Float = IEEE_754::_2008::Binary<width>;
+  using Encoding = detail::UnsignedOfWidth<width / CHAR_BIT>;
+
+private:
+  Encoding value = 0;
+
+  static constexpr Encoding SignMask = Encoding(1) << (width - 1);
+
+public:
+  // Explicit Conversions
+
+  Float getNativeValue() const { return std::bit_cast<Float>(ReverseBytes(value)); }
+  void setNativeValue(Float const native) { value = ReverseBytes(std::bit_cast<Encoding>(native)); }
+
+  Encoding getEncodedValue() const { return value; }
+  void setEncodedValue(Encoding const encodedValue) { value = encodedValue; }
+
+  OtherEndianFloat() = default;
+
+  // Alternative Constructors for arithmetic types
+
+  OtherEndianFloat(Float const native) :
+    value(ReverseBytes(std::bit_cast<Encoding>(native)))
+  {
+  }
+
+  template <typename Arithmetic>
+  requires std::is_arithmetic_v<Arithmetic> && (!std::is_same_v<Arithmetic, Float>)
+  OtherEndianFloat(Arithmetic const native) :
+    OtherEndianFloat(static_cast<Float>(native))
+  {
+  }
+
+  template <int altWidth>
+  OtherEndianFloat(OtherEndianFloat<altWidth> const other) :
+    OtherEndianFloat(static_cast<Float>(other.getNativeValue()))
+  {
+  }
+
+  // Direct initialization from non null pointer
+  OtherEndianFloat(uint8_t const * const data) {
+    assert(data != nullptr);
+    std::memcpy(&value, data, sizeof(Encoding));
+  }
+
+  // Implicit Conversion
+  operator Float() const { return getNativeValue(); }
+
+  // Unary Plus
+  OtherEndianFloat operator+() const { return *this; }
+
+  // Unary Minus flips the sign bit, which needs no byte swap
+  OtherEndianFloat operator-() const {
+    OtherEndianFloat result;
+    result.value = value ^ ReverseBytes(SignMask);
+    return result;
+  }
+
+  // Compound Sum Assignment
+  OtherEndianFloat & operator+=(Float const & rhs) {
+    setNativeValue(getNativeValue() + rhs);
+    return *this;
+  }
+
+  // Compound Difference Assignment
+  OtherEndianFloat & operator-=(Float const & rhs) {
+    setNativeValue(getNativeValue() - rhs);
+    return *this;
+  }
+
+  // Compound Product Assignment
+  OtherEndianFloat & operator*=(Float const & rhs) {
+    setNativeValue(getNativeValue() * rhs);
+    return *this;
+  }
+
+  // Compound Quotient Assignment
+  OtherEndianFloat & operator/=(Float const & rhs) {
+    setNativeValue(getNativeValue() / rhs);
+    return *this;
+  }
+};
+
+// Bulk conversions, sharing the byte reversal kernels of the integral conversions
+
+template <int width>
+void ConvertToNative(std::span<OtherEndianFloat<width> const> const encoded, std::span<typename OtherEndianFloat<width>::Float> const native)
+{
+  static_assert(sizeof(OtherEndianFloat<width>) == sizeof(typename OtherEndianFloat<width>::Float));
+  assert(native.size() >= encoded.size());
+
+  detail::ReverseByteBlocks<width / CHAR_BIT>(reinterpret_cast<std::byte const *>(encoded.data()),
+                                              reinterpret_cast<std::byte *>(native.data()),
+                                              encoded.size());
+}
+
+template <int width>
+void ConvertToEncoded(std::span<typename OtherEndianFloat<width>::Float const> const native, std::span<OtherEndianFloat<width>> const encoded)
+{
+  static_assert(sizeof(OtherEndianFloat<width>) == sizeof(typename OtherEndianFloat<width>::Float));
+  assert(encoded.size() >= native.size());
+
+  detail::ReverseByteBlocks<width / CHAR_BIT>(reinterpret_cast<std::byte const *>(native.data()),
+                                              reinterpret_cast<std::byte *>(encoded.data()),
+                                              native.size());
+}
+
+}} // namespace culyun::endian
+
+namespace {
+
+// Typedef be, le, and oe equivalents to the IEEE 754 binary32 and binary64 types
+
+using float32be_t = std::conditional_t<std::endian::native == std::endian::big, IEEE_754::_2008::Binary<32>, culyun::endian::OtherEndianFloat<32>>;
+using float64be_t = std::conditional_t<std::endian::native == std::endian::big, IEEE_754::_2008::Binary<64>, culyun::endian::OtherEndianFloat<64>>;
+
+using float32le_t = std::conditional_t<std::endian::native == std::endian::little, IEEE_754::_2008::Binary<32>, culyun::endian::OtherEndianFloat<32>>;
+using float64le_t = std::conditional_t<std::endian::native == std::endian::little, IEEE_754::_2008::Binary<64>, culyun::endian::OtherEndianFloat<64>>;
+
+using float32oe_t = culyun::endian::OtherEndianFloat<32>;
+using float64oe_t = culyun::endian::OtherEndianFloat<64>;
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "endian.hpp"
+
+// Hashing of keys by their object representation, i.e. of wire order keys (uint32be_t, uint16be_t, PackedEndian,
+// and structs made of them, such as flow tuples) by their encoded bytes, so a lookup never byte swaps the key.
+//
+// BitwiseHash mixes the key's bytes with a 64 x 64 -> 128-bit multiply, so that the low bits are usable directly
+// by power of two tables.  BitwiseEqual compares the bytes, which for these keys is the same as comparing values.
+//
+// std::hash is specialized for OtherEndian and PackedEndian on the same basis.  Note that the hash of a uint32be_t
+// differs from the hash of the uint32_t it converts to: the two are different key types.
+
+namespace culyun::hash {
+
+template <typename Key>
+concept BitwiseHashable = std::is_trivially_copyable_v<Key> && std::has_unique_object_representations_v<Key>;
+
+namespace detail {
+
+constexpr uint64_t Seed = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t Multiplier = 0xA0761D6478BD642FULL;
+
+// Folded 128-bit product, whose every bit depends on every bit of both operands
+
+constexpr uint64_t Mix(uint64_t const lhs, uint64_t const rhs)
+{
+  unsigned __int128 const product = static_cast<unsigned __int128>(lhs) * rhs;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+inline uint64_t Load(std::byte const * const data, std::size_t const bytes)
+{
+  uint64_t word = 0;
+  std::memcpy(&word, data, bytes);
+  return word;
+}
+
+} // namespace detail
+
+// Hashes [bytes] bytes at data, 8 bytes per multiply
+
+inline uint64_t HashBytes(void const * const data, std::size_t bytes)
+{
+  auto const * position = static_cast<std::byte const *>(data);
+  uint64_t hash = detail::Seed ^ bytes;
+
+  for ( ; bytes > 8 ; bytes -= 8, position += 8) {
+    hash = detail::Mix(hash ^ detail::Load(position, 8), detail::Multiplier);
+  }
+
+  return detail::Mix(hash ^ detail::Load(position, bytes), detail::Multiplier);
+}
+
+template <typename Key>
+requires BitwiseHashable<Key>
+struct BitwiseHash
+{
+  std::size_t operator()(Key const & key) const {
+    if constexpr (sizeof(Key) <= sizeof(uint64_t)) {
+      // A single multiply; the size is a constant, so the load is a single move
+      return static_cast<std::size_t>(detail::Mix(detail::Seed ^ detail::Load(reinterpret_cast<std::byte const *>(&key), sizeof(Key)),
+                                                  detail::Multiplier));
+    } else {
+      return static_cast<std::size_t>(HashBytes(&key, sizeof(Key)));
+    }
+  }
+};
+
+template <typename Key>
+requires BitwiseHashable<Key>
+struct BitwiseEqual
+{
+  bool operator()(Key const & lhs, Key const & rhs) const {
+    return std::memcmp(&lhs, &rhs, sizeof(Key)) == 0;
+  }
+};
+
+} // namespace culyun::hash
+
+// std::hash of the encoded representation
+
+template <typename StorageType>
+struct std::hash<culyun::endian::OtherEndian<StorageType>> : culyun::hash::BitwiseHash<culyun::endian::OtherEndian<StorageType>>
+{
+};
+
+template <typename StorageType, std::endian order, std::size_t width>
+struct std::hash<culyun::endian::PackedEndian<StorageType, order, width>> :
+  culyun::hash::BitwiseHash<culyun::endian::PackedEndian<StorageType, order, width>>
+{
+};
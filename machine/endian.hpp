@@ -9,20 +9,35 @@
 #include <concepts>
 #include <utility>
 
-#include <iostream>
-
 #include <tao/operators.hpp>
 
 namespace culyun { namespace endian {
 
+// __int128 is only reported by std::is_integral in GNU dialects, so it is admitted explicitly
+
+template<typename StorageType>
+concept Integral128 =
+    std::same_as<std::remove_cv_t<StorageType>, __int128> || std::same_as<std::remove_cv_t<StorageType>, unsigned __int128>;
+
 template<typename StorageType>
 concept EndianIntegral =
-    std::is_integral_v<StorageType> && (sizeof(StorageType) == 2 || sizeof(StorageType) == 4 || sizeof(StorageType) == 8);
+    (std::is_integral_v<StorageType> && (sizeof(StorageType) == 2 || sizeof(StorageType) == 4 || sizeof(StorageType) == 8)) ||
+    Integral128<StorageType>;
 
 template<typename StorageType>
 requires EndianIntegral<StorageType>
 StorageType ReverseBytes(StorageType const & value);
 
+namespace detail {
+
+template <std::size_t width>
+using UnsignedOfWidth = std::conditional_t<width == 1, uint8_t,
+                        std::conditional_t<width == 2, uint16_t,
+                        std::conditional_t<width == 4, uint32_t,
+                        std::conditional_t<width == 8, uint64_t, unsigned __int128>>>>;
+
+} // namespace detail
+
 template<>
 uint16_t ReverseBytes<uint16_t>(uint16_t const & value) { return __builtin_bswap16(value); }
 
@@ -41,6 +56,12 @@ uint64_t ReverseBytes<uint64_t>(uint64_t const & value) { return __builtin_bswap
 template<>
 int64_t ReverseBytes<int64_t>(int64_t const & value) { return __builtin_bswap64(value); }
 
+template<>
+unsigned __int128 ReverseBytes<unsigned __int128>(unsigned __int128 const & value) { return __builtin_bswap128(value); }
+
+template<>
+__int128 ReverseBytes<__int128>(__int128 const & value) { return __builtin_bswap128(value); }
+
 template<typename StorageType>
 requires EndianIntegral<StorageType>
 class OtherEndian:
@@ -194,6 +215,25 @@ public:
     return *this;
   }
 
+  // Binary bitwise operations between two OtherEndian operands are byte order invariant,
+  // so combine the encodings directly rather than converting either operand to native.
+  // The operands are constrained (rather than converted) so mixed native / OtherEndian expressions resolve as before.
+
+  friend OtherEndian operator&(std::same_as<OtherEndian> auto lhs, std::same_as<OtherEndian> auto const & rhs) {
+    lhs.value &= rhs.value;
+    return lhs;
+  }
+
+  friend OtherEndian operator|(std::same_as<OtherEndian> auto lhs, std::same_as<OtherEndian> auto const & rhs) {
+    lhs.value |= rhs.value;
+    return lhs;
+  }
+
+  friend OtherEndian operator^(std::same_as<OtherEndian> auto lhs, std::same_as<OtherEndian> auto const & rhs) {
+    lhs.value ^= rhs.value;
+    return lhs;
+  }
+
   // Left Bit-Shift
 
   //OtherEndian operator<<(std::integral auto const & shifts) const {
@@ -207,18 +247,9 @@ public:
   //}
 
   OtherEndian & operator<<=(int const & shifts) {
-    int64_t fred = getNativeValue() << shifts;
-    std::cout << "SWS fred = " << fred << std::endl;
-
-
     if (std::cmp_less(shifts, 1)) return *this;
     if (std::cmp_greater_equal(shifts, sizeof(StorageType) * CHAR_BIT)) return *this;
-    
-
     setNativeValue(getNativeValue() << shifts);
-
-    
-
     return *this;
   }
 
@@ -240,13 +271,312 @@ public:
   }
 };
 
+// PackedEndian stores an integral in a fixed wire byte order with an alignment of one.
+//
+// Unlike OtherEndian, whose value is naturally aligned, a struct of PackedEndian fields has no padding
+// and may be overlaid directly onto a received byte buffer at any offset.
+// Every access copies the wire bytes to / from a register with memcpy, which compiles to a plain (unaligned) load or store,
+// followed by a byte swap when order differs from the native ordering.
+//
+// width may be narrower than StorageType, for wire integrals with no native equivalent (e.g. 24 and 48 bits).
+// These are loaded into the low addresses of a StorageType register, swapped into native order,
+// and then shifted into place; an arithmetic right shift sign extends signed values without branching.
+
+template<typename StorageType, std::endian order, std::size_t width = sizeof(StorageType)>
+requires EndianIntegral<StorageType> && (width > 1) && (width <= sizeof(StorageType))
+class PackedEndian:
+  tao::operators::bitwise< PackedEndian<StorageType, order, width>, StorageType >
+{
+private:
+  uint8_t bytes[width] = {};
+
+  // Whichever the host, a big-endian encoding ends up in the most significant bytes of the register,
+  // and a little-endian encoding in the least significant bytes.
+
+  static constexpr int PaddingBits = CHAR_BIT * (sizeof(StorageType) - width);
+
+public:
+  static constexpr std::endian Order = order;
+  static constexpr std::size_t Width = width;
+
+  // Explicit Conversions
+
+  StorageType getNativeValue() const {
+    StorageType encodedValue = getEncodedValue();
+
+    if constexpr (order != std::endian::native) {
+      encodedValue = ReverseBytes(encodedValue);
+    }
+
+    if constexpr (PaddingBits == 0) {
+      return encodedValue;
+    } else if constexpr (order == std::endian::big) {
+      return encodedValue >> PaddingBits;
+    } else {
+      return static_cast<StorageType>(encodedValue << PaddingBits) >> PaddingBits;
+    }
+  }
+
+  void setNativeValue(StorageType const native) {
+    StorageType encodedValue = native;
+
+    if constexpr (PaddingBits != 0 && order == std::endian::big) {
+      encodedValue = static_cast<StorageType>(encodedValue << PaddingBits);
+    }
+
+    if constexpr (order != std::endian::native) {
+      encodedValue = ReverseBytes(encodedValue);
+    }
+
+    setEncodedValue(encodedValue);
+  }
+
+  // The encoded value holds the wire bytes at its lowest addresses, with any padding bytes zeroed
+
+  StorageType getEncodedValue() const {
+    StorageType encodedValue = 0;
+    std::memcpy(&encodedValue, bytes, width);
+    return encodedValue;
+  }
+
+  void setEncodedValue(StorageType const encodedValue) { std::memcpy(bytes, &encodedValue, width); }
+
+  PackedEndian() = default;
+
+  // Alternative Constructors for Integrals and OtherEndian types
+
+  PackedEndian(EndianIntegral auto const native) {
+    setNativeValue(static_cast<StorageType>(native));
+  }
+
+  PackedEndian & operator=(EndianIntegral auto const rhs) {
+    setNativeValue(static_cast<StorageType>(rhs));
+    return *this;
+  }
+
+  template <typename AltStorageType>
+  PackedEndian(OtherEndian<AltStorageType> const other) :
+    PackedEndian(static_cast<AltStorageType>(other))
+  {
+  }
+
+  template <typename AltStorageType, std::endian altOrder, std::size_t altWidth>
+  PackedEndian(PackedEndian<AltStorageType, altOrder, altWidth> const other) :
+    PackedEndian(static_cast<AltStorageType>(other))
+  {
+  }
+
+  // Direct initialization from non null pointer
+  PackedEndian(uint8_t const * const data) {
+    assert(data != nullptr);
+    std::memcpy(bytes, data, width);
+  }
+
+  // Implicit Conversion
+  operator StorageType() const { return getNativeValue(); }
+
+  // Unary Plus
+  PackedEndian operator+() const { return *this; }
+
+  // Unary Minus
+  PackedEndian operator-() const { return -getNativeValue(); }
+
+  // Prefix Increment
+  PackedEndian & operator++() {
+    setNativeValue(getNativeValue() + 1);
+    return *this;
+  }
+
+  // Postfix Increment
+  PackedEndian operator++(int) {
+    PackedEndian old = *this;
+    operator++();
+    return old;
+  }
+
+  // Prefix Decrement
+  PackedEndian & operator--() {
+    setNativeValue(getNativeValue() - 1);
+    return *this;
+  }
+
+  // Postfix Decrement
+  PackedEndian operator--(int) {
+    PackedEndian old = *this;
+    operator--();
+    return old;
+  }
+
+  // Compound Sum Assignment
+  PackedEndian & operator+=(StorageType const & rhs) {
+    setNativeValue(getNativeValue() + rhs);
+    return *this;
+  }
+
+  // Compound Difference Assignment
+  PackedEndian & operator-=(StorageType const & rhs) {
+    setNativeValue(getNativeValue() - rhs);
+    return *this;
+  }
+
+  // Compound Product Assignment
+  PackedEndian & operator*=(StorageType const & rhs) {
+    setNativeValue(getNativeValue() * rhs);
+    return *this;
+  }
+
+  // Compound Quotient Assignment
+  PackedEndian & operator/=(StorageType const & rhs) {
+    setNativeValue(getNativeValue() / rhs);
+    return *this;
+  }
+
+  // Bitwise operations are byte order invariant, so operate directly on the encoding
+
+  // Bitwise NOT
+  PackedEndian operator~() const {
+    PackedEndian result;
+    result.setEncodedValue(~getEncodedValue());
+    return result;
+  }
+
+  // Bitwise AND
+  PackedEndian & operator&=(StorageType const & rhs) {
+    setEncodedValue(getEncodedValue() & PackedEndian(rhs).getEncodedValue());
+    return *this;
+  }
+
+  // Bitwise OR
+  PackedEndian & operator|=(StorageType const & rhs) {
+    setEncodedValue(getEncodedValue() | PackedEndian(rhs).getEncodedValue());
+    return *this;
+  }
+
+  // Bitwise XOR
+  PackedEndian & operator^=(StorageType const & rhs) {
+    setEncodedValue(getEncodedValue() ^ PackedEndian(rhs).getEncodedValue());
+    return *this;
+  }
+
+  // Left Bit-Shift
+  PackedEndian & operator<<=(int const & shifts) {
+    if (std::cmp_less(shifts, 1)) return *this;
+    if (std::cmp_greater_equal(shifts, width * CHAR_BIT)) return *this;
+    setNativeValue(getNativeValue() << shifts);
+    return *this;
+  }
+
+  // Right Bit-Shift
+  PackedEndian & operator>>=(int const & shifts) {
+    if (std::cmp_less(shifts, 1)) return *this;
+    if (std::cmp_greater_equal(shifts, width * CHAR_BIT)) return *this;
+    setNativeValue(getNativeValue() >> shifts);
+    return *this;
+  }
+};
+
+template<typename StorageType>
+using OtherEndianUnaligned = PackedEndian<StorageType, std::endian::native == std::endian::little ? std::endian::big : std::endian::little>;
+
+template<typename StorageType>
+using NativeEndianUnaligned = PackedEndian<StorageType, std::endian::native>;
+
+// DeferredNative keeps a working native copy of an OtherEndian (or PackedEndian) value,
+// and writes it back, with a single byte swap, when committed or destroyed.
+//
+// Expressions such as a = a * 3 + b - c already evaluate natively, via the implicit conversions,
+// and swap once on assignment.  DeferredNative extends that to chains of compound assignments,
+// which would otherwise swap in and out of native for every step:
+//
+//   {
+//     auto native = endian::Defer(a);
+//     native *= 3;
+//     native += b;
+//     native -= c;
+//   } // a is re-encoded here
+
+template <typename EndianType>
+requires requires (EndianType & value) { value.setNativeValue(value.getNativeValue()); }
+class DeferredNative
+{
+public:
+  using StorageType = decltype(std::declval<EndianType const &>().getNativeValue());
+
+private:
+  EndianType & target;
+  StorageType native;
+
+public:
+  explicit DeferredNative(EndianType & target) : target(target), native(target.getNativeValue()) {}
+
+  ~DeferredNative() { commit(); }
+
+  // DeferredNative is non-copyable and non-moveable
+  DeferredNative(DeferredNative const &) = delete;
+  DeferredNative & operator=(DeferredNative const &) = delete;
+
+  void commit() { target.setNativeValue(native); }
+
+  StorageType & get() { return native; }
+
+  // Implicit Conversion
+  operator StorageType() const { return native; }
+
+  DeferredNative & operator=(StorageType const rhs) { native = rhs; return *this; }
+
+  DeferredNative & operator++() { ++native; return *this; }
+  DeferredNative & operator--() { --native; return *this; }
+
+  DeferredNative & operator+=(StorageType const rhs) { native += rhs; return *this; }
+  DeferredNative & operator-=(StorageType const rhs) { native -= rhs; return *this; }
+  DeferredNative & operator*=(StorageType const rhs) { native *= rhs; return *this; }
+  DeferredNative & operator/=(StorageType const rhs) { native /= rhs; return *this; }
+  DeferredNative & operator%=(StorageType const rhs) { native %= rhs; return *this; }
+
+  DeferredNative & operator&=(StorageType const rhs) { native &= rhs; return *this; }
+  DeferredNative & operator|=(StorageType const rhs) { native |= rhs; return *this; }
+  DeferredNative & operator^=(StorageType const rhs) { native ^= rhs; return *this; }
+
+  // Shifts mirror OtherEndian, ignoring shift counts outside [1, bits)
+
+  DeferredNative & operator<<=(int const shifts) {
+    if (std::cmp_greater_equal(shifts, 1) && std::cmp_less(shifts, sizeof(StorageType) * CHAR_BIT)) native <<= shifts;
+    return *this;
+  }
+
+  DeferredNative & operator>>=(int const shifts) {
+    if (std::cmp_greater_equal(shifts, 1) && std::cmp_less(shifts, sizeof(StorageType) * CHAR_BIT)) native >>= shifts;
+    return *this;
+  }
+};
+
+template <typename EndianType>
+DeferredNative<EndianType> Defer(EndianType & value)
+{
+  return DeferredNative<EndianType>(value);
+}
+
 template <typename IntegralType>
 concept OtherEndianType = std::same_as<IntegralType, OtherEndian< int16_t>> ||
                           std::same_as<IntegralType, OtherEndian<uint16_t>> ||
                           std::same_as<IntegralType, OtherEndian< int32_t>> ||
                           std::same_as<IntegralType, OtherEndian<uint32_t>> ||
                           std::same_as<IntegralType, OtherEndian< int64_t>> ||
-                          std::same_as<IntegralType, OtherEndian<uint64_t>>;
+                          std::same_as<IntegralType, OtherEndian<uint64_t>> ||
+                          std::same_as<IntegralType, OtherEndian< __int128>> ||
+                          std::same_as<IntegralType, OtherEndian<unsigned __int128>>;
+
+// PackedEndian (the *_u_t typedefs, and the 24 and 48-bit wire integrals) of any storage, order and width.
+// Their encoded and big / little-endian values are those of their StorageType native value.
+
+template <typename IntegralType>
+struct IsPackedEndian : std::false_type {};
+
+template <typename StorageType, std::endian order, std::size_t width>
+struct IsPackedEndian<PackedEndian<StorageType, order, width>> : std::true_type {};
+
+template <typename IntegralType>
+concept PackedEndianType = IsPackedEndian<IntegralType>::value;
 
 template <typename IntegralType>
 auto GetNativeValue(IntegralType const & value)
@@ -259,9 +589,13 @@ auto GetNativeValue(IntegralType const & value)
     return value.getNativeValue();
   }
 
+  if constexpr(PackedEndianType<IntegralType>) {
+    return value.getNativeValue();
+  }
+
   // Build time errors
 
-  static_assert(EndianIntegral<IntegralType> || OtherEndianType<IntegralType>,
+  static_assert(EndianIntegral<IntegralType> || OtherEndianType<IntegralType> || PackedEndianType<IntegralType>,
                 "\n\n\\33[1;31mError: Supplied argument is not representable as an Endian Integral!\\33[0m\n\n");
 }
 
@@ -276,9 +610,13 @@ auto GetEncodedValue(IntegralType const & value)
     return value.getEncodedValue();
   }
 
+  if constexpr(PackedEndianType<IntegralType>) {
+    return GetEncodedValue(value.getNativeValue());
+  }
+
   // Build time errors
 
-  static_assert((EndianIntegral<IntegralType> || OtherEndianType<IntegralType>),
+  static_assert((EndianIntegral<IntegralType> || OtherEndianType<IntegralType> || PackedEndianType<IntegralType>),
                 "\n\n\\33[1;31mError: Supplied argument is not representable as an Endian Integral!\\33[0m\n\n");
 }
 
@@ -301,9 +639,13 @@ auto GetBigEndianValue(IntegralType const & value)
     }
   }
 
+  if constexpr(PackedEndianType<IntegralType>) {
+    return GetBigEndianValue(value.getNativeValue());
+  }
+
   // Build time errors
 
-  static_assert(EndianIntegral<IntegralType> || OtherEndianType<IntegralType>,
+  static_assert(EndianIntegral<IntegralType> || OtherEndianType<IntegralType> || PackedEndianType<IntegralType>,
                 "\n\n\\33[1;31mError: Supplied argument is not representable as a Big-Endian Integral!\\33[0m\n\n");
 }
 
@@ -326,9 +668,13 @@ auto GetLittleEndianValue(IntegralType const & value)
     }
   }
 
+  if constexpr(PackedEndianType<IntegralType>) {
+    return GetLittleEndianValue(value.getNativeValue());
+  }
+
   // Build time errors
 
-  static_assert(EndianIntegral<IntegralType> || OtherEndianType<IntegralType>,
+  static_assert(EndianIntegral<IntegralType> || OtherEndianType<IntegralType> || PackedEndianType<IntegralType>,
                 "\n\n\\33[1;31mError: Supplied argument is not representable as a Little-Endian Integral!\\33[0m\n\n");
 }
 
@@ -356,6 +702,12 @@ using int32le_t = std::conditional_t<std::endian::native == std::endian::little,
 using uint64le_t = std::conditional_t<std::endian::native == std::endian::little, uint64_t, culyun::endian::OtherEndian<uint64_t>>;
 using int64le_t = std::conditional_t<std::endian::native == std::endian::little, int64_t, culyun::endian::OtherEndian<int64_t>>;
 
+using uint128be_t = std::conditional_t<std::endian::native == std::endian::big, unsigned __int128, culyun::endian::OtherEndian<unsigned __int128>>;
+using int128be_t = std::conditional_t<std::endian::native == std::endian::big, __int128, culyun::endian::OtherEndian<__int128>>;
+
+using uint128le_t = std::conditional_t<std::endian::native == std::endian::little, unsigned __int128, culyun::endian::OtherEndian<unsigned __int128>>;
+using int128le_t = std::conditional_t<std::endian::native == std::endian::little, __int128, culyun::endian::OtherEndian<__int128>>;
+
 using uint16oe_t = culyun::endian::OtherEndian<uint16_t>;
 using int16oe_t = culyun::endian::OtherEndian<int16_t>;
 
@@ -365,4 +717,57 @@ using int32oe_t = culyun::endian::OtherEndian<int32_t>;
 using uint64oe_t = culyun::endian::OtherEndian<uint64_t>;
 using int64oe_t = culyun::endian::OtherEndian<int64_t>;
 
+using uint128oe_t = culyun::endian::OtherEndian<unsigned __int128>;
+using int128oe_t = culyun::endian::OtherEndian<__int128>;
+
+// Typedef unaligned (packed) be, le, and oe equivalents, suitable for overlaying wire buffers at any offset
+
+using uint16be_u_t = culyun::endian::PackedEndian<uint16_t, std::endian::big>;
+using int16be_u_t = culyun::endian::PackedEndian<int16_t, std::endian::big>;
+
+using uint32be_u_t = culyun::endian::PackedEndian<uint32_t, std::endian::big>;
+using int32be_u_t = culyun::endian::PackedEndian<int32_t, std::endian::big>;
+
+using uint64be_u_t = culyun::endian::PackedEndian<uint64_t, std::endian::big>;
+using int64be_u_t = culyun::endian::PackedEndian<int64_t, std::endian::big>;
+
+using uint16le_u_t = culyun::endian::PackedEndian<uint16_t, std::endian::little>;
+using int16le_u_t = culyun::endian::PackedEndian<int16_t, std::endian::little>;
+
+using uint32le_u_t = culyun::endian::PackedEndian<uint32_t, std::endian::little>;
+using int32le_u_t = culyun::endian::PackedEndian<int32_t, std::endian::little>;
+
+using uint64le_u_t = culyun::endian::PackedEndian<uint64_t, std::endian::little>;
+using int64le_u_t = culyun::endian::PackedEndian<int64_t, std::endian::little>;
+
+using uint16oe_u_t = culyun::endian::OtherEndianUnaligned<uint16_t>;
+using int16oe_u_t = culyun::endian::OtherEndianUnaligned<int16_t>;
+
+using uint32oe_u_t = culyun::endian::OtherEndianUnaligned<uint32_t>;
+using int32oe_u_t = culyun::endian::OtherEndianUnaligned<int32_t>;
+
+using uint64oe_u_t = culyun::endian::OtherEndianUnaligned<uint64_t>;
+using int64oe_u_t = culyun::endian::OtherEndianUnaligned<int64_t>;
+
+using uint128be_u_t = culyun::endian::PackedEndian<unsigned __int128, std::endian::big>;
+using int128be_u_t = culyun::endian::PackedEndian<__int128, std::endian::big>;
+
+using uint128le_u_t = culyun::endian::PackedEndian<unsigned __int128, std::endian::little>;
+using int128le_u_t = culyun::endian::PackedEndian<__int128, std::endian::little>;
+
+// Typedef wire integrals with no native equivalent.
+// These are always packed, and are manipulated through the next widest native integral.
+
+using uint24be_t = culyun::endian::PackedEndian<uint32_t, std::endian::big, 3>;
+using int24be_t = culyun::endian::PackedEndian<int32_t, std::endian::big, 3>;
+
+using uint48be_t = culyun::endian::PackedEndian<uint64_t, std::endian::big, 6>;
+using int48be_t = culyun::endian::PackedEndian<int64_t, std::endian::big, 6>;
+
+using uint24le_t = culyun::endian::PackedEndian<uint32_t, std::endian::little, 3>;
+using int24le_t = culyun::endian::PackedEndian<int32_t, std::endian::little, 3>;
+
+using uint48le_t = culyun::endian::PackedEndian<uint64_t, std::endian::little, 6>;
+using int48le_t = culyun::endian::PackedEndian<int64_t, std::endian::little, 6>;
+
 }
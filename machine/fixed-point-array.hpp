@@ -0,0 +1,582 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "fixed-point.hpp"
+
+// Elementwise kernels over arrays of FixedPrecision values, e.g. a signal pipeline of Q-format samples.
+//
+//   Multiply(a, b, products)             products[i] = a[i] * b[i]
+//   Scale(a, factor, products)           products[i] = a[i] * factor
+//   MultiplyAccumulate(a, b, sums)       sums[i] += a[i] * b[i]
+//   Divide(a, b, quotients)              quotients[i] = a[i] / b[i]
+//
+// Arguments are any contiguous ranges (std::vector, std::array, std::span) of FixedPrecision values.
+// The results have the traits the scalar operators derive (ProductTraits, QuotientTraits), and the same values,
+// provided every operand's data is within its traits' bits, as the vector sequences rely on that bound.
+//
+// FastestIntegralType is 64 bits wide for most traits, so the kernels work in 64-bit lanes, 8 per iteration
+// with AVX-512 and 4 with AVX2, widening narrower operands as they are loaded.  The product sequence is chosen
+// from the operands' traits:
+//
+// - Operands of up to 31 bits (32 if both are unsigned): a single widening 32 x 32 -> 64-bit multiply (vpmuldq / vpmuludq).
+// - Wider operands: a 64-bit low multiply (vpmullq with AVX-512DQ, otherwise three vpmuludq).
+//
+// x86 has no vector integer divide.  When the quotient and divisor fit in 51 bits, quotients are computed exactly
+// in double precision (|dividend| < 2^53 makes the truncated quotient exact); otherwise division is scalar.
+//
+// Products whose bits exceed maxBits are rounded from their full width by the scalar operator.  Accumulations apply
+// the sums' overflow policy: Saturate as a vector min / max (vpminsq / vpmaxsq, or compare and blend with AVX2),
+// Trap as a vector compare.  Quotients are only computed in vectors when they truncate.
+//
+// Remaining elements, and builds without AVX2, use the scalar operators.
+//
+// ToFloat and FromFloat convert arrays to and from float (or double), with the results of the scalar conversions.
+// The float kernels convert 8 values per iteration, in 32-bit lanes for data of up to 31 bits (any width with
+// AVX-512DQ), with saturation as a min / max of the scaled floats before the rounding conversion.
+
+namespace machine {
+
+template <typename T>
+concept FixedPrecisionType = requires { T::Traits; } && std::same_as<std::remove_cv_t<T>, FixedPrecision<T::Traits>>;
+
+template <typename Range>
+concept FixedPrecisionRange =
+    std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range> && FixedPrecisionType<std::ranges::range_value_t<Range>>;
+
+template <FixedPrecisionType Multiplicand, FixedPrecisionType Multiplier>
+using ProductOf = FixedPrecision<ProductTraits<Multiplicand::Traits, Multiplier::Traits>()>;
+
+template <FixedPrecisionType Dividend, FixedPrecisionType Divisor>
+using QuotientOf = FixedPrecision<QuotientTraits<Dividend::Traits, Divisor::Traits>()>;
+
+namespace detail {
+
+template <typename Range>
+using ElementOf = std::ranges::range_value_t<Range>;
+
+template <FixedPrecisionTraits traits>
+using DataOf = typename FixedPrecision<traits>::IntegralType;
+
+enum class Operand { Elementwise, Broadcast, Accumulate };
+
+// Operands of up to 31 bits fit a signed 32-bit lane whatever their signedness; unsigned operands fit up to 32 bits
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b>
+constexpr bool MultipliesSigned32 = a.bits <= 31 && b.bits <= 31;
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b>
+constexpr bool MultipliesUnsigned32 = !a.isSigned && !b.isSigned && a.bits <= 32 && b.bits <= 32;
+
+#if defined(__AVX512F__)
+
+struct Lanes512
+{
+  using Vector = __m512i;
+  using Doubles = __m512d;
+
+  static constexpr std::size_t Count = 8;
+
+  template <typename T>
+  static Vector Load(T const * const data) {
+    if constexpr (sizeof(T) == 8) {
+      return _mm512_loadu_si512(data);
+    } else if constexpr (sizeof(T) == 4) {
+      __m256i const narrow = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data));
+      return std::is_signed_v<T> ? _mm512_cvtepi32_epi64(narrow) : _mm512_cvtepu32_epi64(narrow);
+    } else if constexpr (sizeof(T) == 2) {
+      __m128i const narrow = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+      return std::is_signed_v<T> ? _mm512_cvtepi16_epi64(narrow) : _mm512_cvtepu16_epi64(narrow);
+    } else {
+      __m128i const narrow = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(data));
+      return std::is_signed_v<T> ? _mm512_cvtepi8_epi64(narrow) : _mm512_cvtepu8_epi64(narrow);
+    }
+  }
+
+  template <typename T>
+  static void Store(T * const data, Vector const value) { _mm512_storeu_si512(data, value); }
+
+  static Vector Broadcast(int64_t const value) { return _mm512_set1_epi64(value); }
+
+  static Vector Add(Vector const lhs, Vector const rhs) { return _mm512_add_epi64(lhs, rhs); }
+
+  static int64_t Sum(Vector const value) { return _mm512_reduce_add_epi64(value); }
+
+  static Vector Min(Vector const lhs, Vector const rhs) { return _mm512_min_epi64(lhs, rhs); }
+  static Vector Max(Vector const lhs, Vector const rhs) { return _mm512_max_epi64(lhs, rhs); }
+
+  static bool AnyGreater(Vector const lhs, Vector const rhs) { return _mm512_cmpgt_epi64_mask(lhs, rhs) != 0; }
+
+  template <int shift>
+  static Vector ShiftLeft(Vector const value) { return _mm512_slli_epi64(value, shift); }
+
+  static Vector MultiplySigned32(Vector const lhs, Vector const rhs) { return _mm512_mul_epi32(lhs, rhs); }
+  static Vector MultiplyUnsigned32(Vector const lhs, Vector const rhs) { return _mm512_mul_epu32(lhs, rhs); }
+
+  static Vector Multiply64(Vector const lhs, Vector const rhs) {
+#if defined(__AVX512DQ__)
+    return _mm512_mullo_epi64(lhs, rhs);
+#else
+    Vector const cross = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(lhs, 32), rhs),
+                                          _mm512_mul_epu32(lhs, _mm512_srli_epi64(rhs, 32)));
+    return _mm512_add_epi64(_mm512_mul_epu32(lhs, rhs), _mm512_slli_epi64(cross, 32));
+#endif
+  }
+
+  // Exact for |value| < 2^51: the integer is added to the mantissa of 1.5 * 2^52
+
+  static Doubles ToDoubles(Vector const value) {
+    return _mm512_sub_pd(_mm512_castsi512_pd(_mm512_add_epi64(value, _mm512_castpd_si512(_mm512_set1_pd(0x1.8p52)))),
+                         _mm512_set1_pd(0x1.8p52));
+  }
+
+  static Vector FromDoubles(Doubles const value) {
+    return _mm512_sub_epi64(_mm512_castpd_si512(_mm512_add_pd(value, _mm512_set1_pd(0x1.8p52))),
+                            _mm512_castpd_si512(_mm512_set1_pd(0x1.8p52)));
+  }
+
+  static Doubles DivideTruncated(Doubles const dividend, Doubles const divisor) {
+    return _mm512_roundscale_pd(_mm512_div_pd(dividend, divisor), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  }
+};
+
+using Lanes = Lanes512;
+
+#elif defined(__AVX2__)
+
+struct Lanes256
+{
+  using Vector = __m256i;
+  using Doubles = __m256d;
+
+  static constexpr std::size_t Count = 4;
+
+  template <typename T>
+  static Vector Load(T const * const data) {
+    if constexpr (sizeof(T) == 8) {
+      return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data));
+    } else if constexpr (sizeof(T) == 4) {
+      __m128i const narrow = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+      return std::is_signed_v<T> ? _mm256_cvtepi32_epi64(narrow) : _mm256_cvtepu32_epi64(narrow);
+    } else if constexpr (sizeof(T) == 2) {
+      __m128i const narrow = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(data));
+      return std::is_signed_v<T> ? _mm256_cvtepi16_epi64(narrow) : _mm256_cvtepu16_epi64(narrow);
+    } else {
+      int32_t word;
+      std::memcpy(&word, data, sizeof(word));
+      __m128i const narrow = _mm_cvtsi32_si128(word);
+      return std::is_signed_v<T> ? _mm256_cvtepi8_epi64(narrow) : _mm256_cvtepu8_epi64(narrow);
+    }
+  }
+
+  template <typename T>
+  static void Store(T * const data, Vector const value) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(data), value); }
+
+  static Vector Broadcast(int64_t const value) { return _mm256_set1_epi64x(value); }
+
+  static Vector Add(Vector const lhs, Vector const rhs) { return _mm256_add_epi64(lhs, rhs); }
+
+  static int64_t Sum(Vector const value) {
+    __m128i const half = _mm_add_epi64(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+    return _mm_cvtsi128_si64(_mm_add_epi64(half, _mm_unpackhi_epi64(half, half)));
+  }
+
+  // No 64-bit min / max before AVX-512: a compare and a blend
+  static Vector Min(Vector const lhs, Vector const rhs) { return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(lhs, rhs)); }
+  static Vector Max(Vector const lhs, Vector const rhs) { return _mm256_blendv_epi8(rhs, lhs, _mm256_cmpgt_epi64(lhs, rhs)); }
+
+  static bool AnyGreater(Vector const lhs, Vector const rhs) { return _mm256_movemask_epi8(_mm256_cmpgt_epi64(lhs, rhs)) != 0; }
+
+  template <int shift>
+  static Vector ShiftLeft(Vector const value) { return _mm256_slli_epi64(value, shift); }
+
+  static Vector MultiplySigned32(Vector const lhs, Vector const rhs) { return _mm256_mul_epi32(lhs, rhs); }
+  static Vector MultiplyUnsigned32(Vector const lhs, Vector const rhs) { return _mm256_mul_epu32(lhs, rhs); }
+
+  // The low 64 bits of the product, from three 32 x 32 -> 64-bit multiplies
+  static Vector Multiply64(Vector const lhs, Vector const rhs) {
+    Vector const cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(lhs, 32), rhs),
+                                          _mm256_mul_epu32(lhs, _mm256_srli_epi64(rhs, 32)));
+    return _mm256_add_epi64(_mm256_mul_epu32(lhs, rhs), _mm256_slli_epi64(cross, 32));
+  }
+
+  // Exact for |value| < 2^51: the integer is added to the mantissa of 1.5 * 2^52
+
+  static Doubles ToDoubles(Vector const value) {
+    return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(value, _mm256_castpd_si256(_mm256_set1_pd(0x1.8p52)))),
+                         _mm256_set1_pd(0x1.8p52));
+  }
+
+  static Vector FromDoubles(Doubles const value) {
+    return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(value, _mm256_set1_pd(0x1.8p52))),
+                            _mm256_castpd_si256(_mm256_set1_pd(0x1.8p52)));
+  }
+
+  static Doubles DivideTruncated(Doubles const dividend, Doubles const divisor) {
+    return _mm256_round_pd(_mm256_div_pd(dividend, divisor), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  }
+};
+
+using Lanes = Lanes256;
+
+#endif
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+
+// The products of operands whose data is within the traits' bits, by the narrowest multiply that holds them
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b>
+typename Lanes::Vector MultiplyVectors(typename Lanes::Vector const lhs, typename Lanes::Vector const rhs)
+{
+  if constexpr (MultipliesSigned32<a, b>) {
+    return Lanes::MultiplySigned32(lhs, rhs);
+  } else if constexpr (MultipliesUnsigned32<a, b>) {
+    return Lanes::MultiplyUnsigned32(lhs, rhs);
+  } else {
+    return Lanes::Multiply64(lhs, rhs);
+  }
+}
+
+#endif
+
+// Each kernel returns the number of elements it processed, leaving the remainder to the scalar operators
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b, Operand operand>
+std::size_t MultiplyLanes([[maybe_unused]] DataOf<a> const * const lhs,
+                          [[maybe_unused]] DataOf<b> const * const rhs,
+                          [[maybe_unused]] DataOf<ProductTraits<a, b>()> * const result,
+                          [[maybe_unused]] std::size_t const count)
+{
+  std::size_t i = 0;
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+  constexpr FixedPrecisionTraits productTraits = ProductTraits<a, b>();
+
+  // Products held in maxBits are rounded from 128 bits, by the scalar operator.  Accumulations are bounded by a
+  // min / max, or checked, in 64-bit lanes, which the sum of two values of up to 62 bits cannot overflow.
+  constexpr bool Vectorized = sizeof(DataOf<productTraits>) == 8 && a.bits + b.bits <= productTraits.maxBits &&
+                              (operand != Operand::Accumulate || productTraits.overflow == OverflowPolicy::Wrap || productTraits.bits <= 62);
+
+  if constexpr (Vectorized) {
+    using Vector = typename Lanes::Vector;
+
+    // Only a broadcast factor is read up front, as the multipliers of the other operands may be an empty range
+    Vector const factor = operand == Operand::Broadcast ? Lanes::Broadcast(static_cast<int64_t>(*rhs)) : Vector{};
+    Vector const maxData = Lanes::Broadcast(static_cast<int64_t>(MaxData<productTraits>));
+    Vector const minData = Lanes::Broadcast(static_cast<int64_t>(MinData<productTraits>));
+
+    for ( ; i + Lanes::Count <= count ; i += Lanes::Count) {
+      Vector const multiplicand = Lanes::Load(lhs + i);
+      Vector const multiplier = operand == Operand::Broadcast ? factor : Lanes::Load(rhs + i);
+
+      Vector product = MultiplyVectors<a, b>(multiplicand, multiplier);
+
+      if constexpr (operand == Operand::Accumulate) {
+        product = Lanes::Add(Lanes::Load(result + i), product);
+
+        if constexpr (productTraits.overflow == OverflowPolicy::Saturate) {
+          product = Lanes::Min(Lanes::Max(product, minData), maxData);
+        } else if constexpr (productTraits.overflow == OverflowPolicy::Trap) {
+          if (Lanes::AnyGreater(product, maxData) || Lanes::AnyGreater(minData, product)) __builtin_trap();
+        }
+      }
+
+      Lanes::Store(result + i, product);
+    }
+  }
+#endif
+
+  return i;
+}
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b>
+std::size_t DivideLanes([[maybe_unused]] DataOf<a> const * const lhs,
+                        [[maybe_unused]] DataOf<b> const * const rhs,
+                        [[maybe_unused]] DataOf<QuotientTraits<a, b>()> * const result,
+                        [[maybe_unused]] std::size_t const count)
+{
+  std::size_t i = 0;
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+  constexpr FixedPrecisionTraits quotientTraits = QuotientTraits<a, b>();
+  using Quotient = DataOf<quotientTraits>;
+
+  // Mirrors operator/ when the dividend is shifted left into the quotient's bits, and the division is not
+  // performed in unsigned arithmetic for a signed quotient (a signed 64-bit dividend over an unsigned 64-bit divisor)
+  // (the double quotient, being rounded, cannot tell ties from near ties, so other rounding policies are scalar)
+  constexpr bool Exact = sizeof(Quotient) == 8 && a.bits <= quotientTraits.maxBits && quotientTraits.maxBits <= 51 && b.bits <= 51 &&
+                         (std::is_signed_v<std::common_type_t<Quotient, DataOf<b>>> || !std::is_signed_v<Quotient>) &&
+                         quotientTraits.rounding == RoundingPolicy::Truncate;
+
+  if constexpr (Exact) {
+    using Vector = typename Lanes::Vector;
+
+    Vector const maxData = Lanes::Broadcast(static_cast<int64_t>(MaxData<quotientTraits>));
+
+    for ( ; i + Lanes::Count <= count ; i += Lanes::Count) {
+      Vector const dividend = Lanes::template ShiftLeft<quotientTraits.maxBits - a.bits>(Lanes::Load(lhs + i));
+      Vector const divisor = Lanes::Load(rhs + i);
+
+      Vector quotient = Lanes::FromDoubles(Lanes::DivideTruncated(Lanes::ToDoubles(dividend), Lanes::ToDoubles(divisor)));
+
+      // Only the most negative dividend over -1 exceeds the quotient's bits, as by operator/
+      if constexpr (quotientTraits.overflow == OverflowPolicy::Saturate) {
+        quotient = Lanes::Min(quotient, maxData);
+      } else if constexpr (quotientTraits.overflow == OverflowPolicy::Trap) {
+        if (Lanes::AnyGreater(quotient, maxData)) __builtin_trap();
+      }
+
+      Lanes::Store(result + i, quotient);
+    }
+  }
+#endif
+
+  return i;
+}
+
+template <typename Float>
+concept FloatType = std::same_as<Float, float> || std::same_as<Float, double>;
+
+template <typename Range>
+concept FloatRange = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range> && FloatType<std::ranges::range_value_t<Range>>;
+
+template <FixedPrecisionTraits traits, typename Float>
+std::size_t ToFloatLanes([[maybe_unused]] DataOf<traits> const * const data,
+                         [[maybe_unused]] Float * const floats,
+                         [[maybe_unused]] std::size_t const count)
+{
+  std::size_t i = 0;
+
+  [[maybe_unused]] constexpr bool Convertible = std::same_as<Float, float> && sizeof(DataOf<traits>) == 8 &&
+                               traits.power >= std::numeric_limits<float>::min_exponent && traits.power < std::numeric_limits<float>::max_exponent;
+
+#if defined(__AVX512DQ__)
+  if constexpr (Convertible) {
+    __m256 const scale = _mm256_set1_ps(PowerOfTwo<float, traits.power>());
+
+    for ( ; i + 8 <= count ; i += 8) {
+      __m512i const value = _mm512_loadu_si512(data + i);
+      __m256 const converted = traits.isSigned ? _mm512_cvtepi64_ps(value) : _mm512_cvtepu64_ps(value);
+      _mm256_storeu_ps(floats + i, _mm256_mul_ps(converted, scale));
+    }
+  }
+#elif defined(__AVX2__)
+  if constexpr (Convertible && traits.bits <= 31) {
+    __m256 const scale = _mm256_set1_ps(PowerOfTwo<float, traits.power>());
+    __m256i const lowHalves = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    for ( ; i + 8 <= count ; i += 8) {
+      // The data fits the low 32 bits of each 64-bit lane
+      __m256i const first = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i)), lowHalves);
+      __m256i const second = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i + 4)), lowHalves);
+      __m256i const value = _mm256_permute2x128_si256(first, second, 0x20);
+
+      _mm256_storeu_ps(floats + i, _mm256_mul_ps(_mm256_cvtepi32_ps(value), scale));
+    }
+  }
+#endif
+
+  return i;
+}
+
+template <FixedPrecisionTraits traits, RoundingPolicy rounding, OverflowPolicy overflow, typename Float>
+std::size_t FromFloatLanes([[maybe_unused]] Float const * const floats,
+                           [[maybe_unused]] DataOf<traits> * const data,
+                           [[maybe_unused]] std::size_t const count)
+{
+  std::size_t i = 0;
+
+#if defined(__AVX2__)
+  using Fixed = FixedPrecision<traits>;
+
+  // Saturated, rounded values of up to 31 bits convert exactly through 32-bit lanes
+  constexpr bool Convertible = std::same_as<Float, float> && sizeof(DataOf<traits>) == 8 && traits.bits <= 31 &&
+                               overflow == OverflowPolicy::Saturate &&
+                               -traits.power >= std::numeric_limits<float>::min_exponent && -traits.power < std::numeric_limits<float>::max_exponent;
+
+  if constexpr (Convertible) {
+    __m256 const scale = _mm256_set1_ps(PowerOfTwo<float, -traits.power>());
+    __m256 const min = _mm256_set1_ps(static_cast<float>(Fixed::MinData));
+    __m256 const max = _mm256_set1_ps(FloorToFloat<float>(Fixed::MaxData));
+
+    for ( ; i + 8 <= count ; i += 8) {
+      __m256 value = _mm256_mul_ps(_mm256_loadu_ps(floats + i), scale);
+
+      // As Clamp: maxps returns its second operand for NaN
+      value = _mm256_min_ps(_mm256_max_ps(value, min), max);
+
+      __m256i integral;
+
+      if constexpr (rounding == RoundingPolicy::Truncate) {
+        integral = _mm256_cvttps_epi32(value);
+      } else if constexpr (rounding == RoundingPolicy::Convergent) {
+        integral = _mm256_cvtps_epi32(value);
+      } else {
+        __m256 const sign = _mm256_and_ps(value, _mm256_set1_ps(-0.0f));
+        __m256 const truncated = _mm256_round_ps(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        __m256 const fraction = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _mm256_sub_ps(value, truncated));
+        __m256 const away = _mm256_and_ps(_mm256_cmp_ps(fraction, _mm256_set1_ps(0.5f), _CMP_GE_OQ), _mm256_or_ps(_mm256_set1_ps(1.0f), sign));
+        integral = _mm256_cvttps_epi32(_mm256_add_ps(truncated, away));
+      }
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), _mm256_cvtepi32_epi64(_mm256_castsi256_si128(integral)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i + 4), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(integral, 1)));
+    }
+  }
+#endif
+
+  return i;
+}
+
+template <typename Range>
+auto * DataPointer(Range && range)
+{
+  using Element = std::remove_reference_t<std::ranges::range_reference_t<Range>>;
+  using Data = std::conditional_t<std::is_const_v<Element>,
+                                  typename ElementOf<Range>::IntegralType const,
+                                  typename ElementOf<Range>::IntegralType>;
+
+  static_assert(sizeof(ElementOf<Range>) == sizeof(Data) && std::is_standard_layout_v<ElementOf<Range>>);
+  return reinterpret_cast<Data *>(std::ranges::data(range));
+}
+
+} // namespace detail
+
+// products[i] = multiplicands[i] * multipliers[i]
+
+template <FixedPrecisionRange Multiplicands, FixedPrecisionRange Multipliers, FixedPrecisionRange Products>
+void Multiply(Multiplicands const & multiplicands, Multipliers const & multipliers, Products && products)
+{
+  using Multiplicand = detail::ElementOf<Multiplicands>;
+  using Multiplier = detail::ElementOf<Multipliers>;
+
+  static_assert(std::same_as<detail::ElementOf<Products>, ProductOf<Multiplicand, Multiplier>>,
+                "\n\n\33[1;31mError: The products must have the traits of the product of the operands!\33[0m\n\n");
+
+  std::size_t const count = std::ranges::size(multiplicands);
+  assert(std::ranges::size(multipliers) >= count && std::ranges::size(products) >= count);
+
+  std::size_t i = detail::MultiplyLanes<Multiplicand::Traits, Multiplier::Traits, detail::Operand::Elementwise>(
+      detail::DataPointer(multiplicands), detail::DataPointer(multipliers), detail::DataPointer(products), count);
+
+  for ( ; i < count ; ++i) {
+    std::ranges::data(products)[i] = std::ranges::data(multiplicands)[i] * std::ranges::data(multipliers)[i];
+  }
+}
+
+// products[i] = multiplicands[i] * factor
+
+template <FixedPrecisionRange Multiplicands, FixedPrecisionType Multiplier, FixedPrecisionRange Products>
+void Scale(Multiplicands const & multiplicands, Multiplier const factor, Products && products)
+{
+  using Multiplicand = detail::ElementOf<Multiplicands>;
+
+  static_assert(std::same_as<detail::ElementOf<Products>, ProductOf<Multiplicand, Multiplier>>,
+                "\n\n\33[1;31mError: The products must have the traits of the product of the operands!\33[0m\n\n");
+
+  std::size_t const count = std::ranges::size(multiplicands);
+  assert(std::ranges::size(products) >= count);
+
+  std::size_t i = detail::MultiplyLanes<Multiplicand::Traits, Multiplier::Traits, detail::Operand::Broadcast>(
+      detail::DataPointer(multiplicands), &factor.data, detail::DataPointer(products), count);
+
+  for ( ; i < count ; ++i) {
+    std::ranges::data(products)[i] = std::ranges::data(multiplicands)[i] * factor;
+  }
+}
+
+// sums[i] += multiplicands[i] * multipliers[i], fitted to the sums' bits by their overflow policy, as by operator+=
+
+template <FixedPrecisionRange Multiplicands, FixedPrecisionRange Multipliers, FixedPrecisionRange Sums>
+void MultiplyAccumulate(Multiplicands const & multiplicands, Multipliers const & multipliers, Sums && sums)
+{
+  using Multiplicand = detail::ElementOf<Multiplicands>;
+  using Multiplier = detail::ElementOf<Multipliers>;
+  using Sum = detail::ElementOf<Sums>;
+
+  static_assert(std::same_as<Sum, ProductOf<Multiplicand, Multiplier>>,
+                "\n\n\33[1;31mError: The sums must have the traits of the product of the operands!\33[0m\n\n");
+
+  std::size_t const count = std::ranges::size(multiplicands);
+  assert(std::ranges::size(multipliers) >= count && std::ranges::size(sums) >= count);
+
+  std::size_t i = detail::MultiplyLanes<Multiplicand::Traits, Multiplier::Traits, detail::Operand::Accumulate>(
+      detail::DataPointer(multiplicands), detail::DataPointer(multipliers), detail::DataPointer(sums), count);
+
+  for ( ; i < count ; ++i) {
+    std::ranges::data(sums)[i] += std::ranges::data(multiplicands)[i] * std::ranges::data(multipliers)[i];
+  }
+}
+
+// quotients[i] = dividends[i] / divisors[i].  Every divisor must be non-zero.
+
+template <FixedPrecisionRange Dividends, FixedPrecisionRange Divisors, FixedPrecisionRange Quotients>
+void Divide(Dividends const & dividends, Divisors const & divisors, Quotients && quotients)
+{
+  using Dividend = detail::ElementOf<Dividends>;
+  using Divisor = detail::ElementOf<Divisors>;
+
+  static_assert(std::same_as<detail::ElementOf<Quotients>, QuotientOf<Dividend, Divisor>>,
+                "\n\n\33[1;31mError: The quotients must have the traits of the quotient of the operands!\33[0m\n\n");
+
+  std::size_t const count = std::ranges::size(dividends);
+  assert(std::ranges::size(divisors) >= count && std::ranges::size(quotients) >= count);
+
+  std::size_t i = detail::DivideLanes<Dividend::Traits, Divisor::Traits>(
+      detail::DataPointer(dividends), detail::DataPointer(divisors), detail::DataPointer(quotients), count);
+
+  for ( ; i < count ; ++i) {
+    std::ranges::data(quotients)[i] = std::ranges::data(dividends)[i] / std::ranges::data(divisors)[i];
+  }
+}
+
+// floats[i] = Float(fixeds[i])
+
+template <FixedPrecisionRange Fixeds, detail::FloatRange Floats>
+void ToFloat(Fixeds const & fixeds, Floats && floats)
+{
+  using Fixed = detail::ElementOf<Fixeds>;
+  using Float = detail::ElementOf<Floats>;
+
+  std::size_t const count = std::ranges::size(fixeds);
+  assert(std::ranges::size(floats) >= count);
+
+  Float * const output = std::ranges::data(floats);
+
+  std::size_t i = detail::ToFloatLanes<Fixed::Traits>(detail::DataPointer(fixeds), output, count);
+
+  for ( ; i < count ; ++i) {
+    output[i] = static_cast<Float>(std::ranges::data(fixeds)[i]);
+  }
+}
+
+// fixeds[i] = Fixed::FromFloat<rounding, overflow>(floats[i])
+
+template <RoundingPolicy rounding = RoundingPolicy::Convergent, OverflowPolicy overflow = OverflowPolicy::Saturate,
+          detail::FloatRange Floats, FixedPrecisionRange Fixeds>
+void FromFloat(Floats const & floats, Fixeds && fixeds)
+{
+  using Fixed = detail::ElementOf<Fixeds>;
+
+  std::size_t const count = std::ranges::size(floats);
+  assert(std::ranges::size(fixeds) >= count);
+
+  std::size_t i = detail::FromFloatLanes<Fixed::Traits, rounding, overflow>(std::ranges::data(floats), detail::DataPointer(fixeds), count);
+
+  for ( ; i < count ; ++i) {
+    std::ranges::data(fixeds)[i] = Fixed::template FromFloat<rounding, overflow>(std::ranges::data(floats)[i]);
+  }
+}
+
+} // namespace machine
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#include "fixed-point.hpp"
+#include "fixed-point-array.hpp"
+
+// Fused expressions of FixedPrecision values, e.g. the multiply-accumulate chain of a filter or a rotation:
+//
+//   Q1_14 const y = Fused(a) * b + Fused(c) * d - Fused(e) * f;
+//
+// Each operator of FixedPrecision values gives a FixedPrecision, rounded and fitted to its traits.  The operators of
+// fused expressions instead build the expression tree, whose exact traits are derived at compile time by the trait
+// arithmetic of the scalar operators (ProductTraits, SumTraits) without their maxBits.  The tree is evaluated when
+// it initializes (or is assigned to) a FixedPrecision: every node is computed exactly in one common integral,
+// int64_t when the exact value fits in 62 bits and __int128 up to 126 bits, at its own power, each sum shifting its
+// operands to the finer power by a constant.  The exact value is then rounded once to the result's power and fitted
+// once to its bits, by its policies, as by FromFixed.
+//
+// Fused(x) makes a value an operand of a fused expression, and any operator with a fused operand is fused, so a
+// single Fused per product suffices (a product of two plain values is evaluated by the scalar operator first).
+// Evaluate(expression) gives the FixedPrecision of the expression's Traits: those the scalar operators would derive,
+// held in maxBits (the least of its operands') by dropping least significant bits, with the same value when no node
+// exceeds maxBits.
+
+namespace machine {
+
+namespace detail {
+
+// Traits whose arithmetic is exact up to the 126 bits an __int128 holds without overflow.  Each node checks that its
+// own exact width is within them, as the trait arithmetic would otherwise hold a wider node in 126 bits, silently.
+
+template <FixedPrecisionTraits traits>
+constexpr FixedPrecisionTraits UncappedTraits = {.isSigned = traits.isSigned, .bits = traits.bits, .power = traits.power,
+                                                 .minBits = traits.minBits, .maxBits = 126,
+                                                 .rounding = traits.rounding, .overflow = traits.overflow};
+
+// The exact traits held in maxBits, as ProductTraits and SumTraits hold theirs
+
+template <FixedPrecisionTraits exactTraits, int maxBits>
+constexpr FixedPrecisionTraits CappedTraits()
+{
+  constexpr int bits = std::min(exactTraits.bits, maxBits);
+
+  return {
+    .isSigned = exactTraits.isSigned,
+    .bits = bits,
+    .power = exactTraits.power + exactTraits.bits - bits,
+    .minBits = std::min(bits, exactTraits.minBits),
+    .maxBits = maxBits,
+    .rounding = exactTraits.rounding,
+    .overflow = exactTraits.overflow};
+}
+
+// Every node holds its operands by value, and provides its exact traits, the maxBits of its operands, the traits
+// they give, and its exact value in the Wide integral of the whole tree
+
+template <typename Node>
+struct FusedNode
+{
+  static constexpr bool IsFused = true;
+
+  template <FixedPrecisionTraits traits>
+  constexpr auto evaluate() const
+  {
+    constexpr FixedPrecisionTraits exactTraits = Node::ExactTraits;
+
+    // A product of the most negative values needs one more bit than the traits' bits
+    using Wide = std::conditional_t<exactTraits.bits <= 62, int64_t, __int128>;
+
+    return Fit<traits>(Align<traits, exactTraits>(static_cast<Node const &>(*this).template exact<Wide>()));
+  }
+};
+
+template <FixedPrecisionTraits traits>
+struct FusedValue : FusedNode<FusedValue<traits>>
+{
+  static_assert(traits.bits <= 126, "\n\n\33[1;31mError: The exact value of the expression exceeds 128 bits!\33[0m\n\n");
+
+  static constexpr FixedPrecisionTraits ExactTraits = UncappedTraits<traits>;
+  static constexpr int MaxBits = traits.maxBits;
+  static constexpr FixedPrecisionTraits Traits = CappedTraits<ExactTraits, MaxBits>();
+
+  FixedPrecision<traits> value;
+
+  constexpr FusedValue(FixedPrecision<traits> const value) : value(value) {}
+
+  template <typename Wide>
+  constexpr Wide exact() const { return static_cast<Wide>(value.data); }
+};
+
+template <typename Multiplicand, typename Multiplier>
+struct FusedProduct : FusedNode<FusedProduct<Multiplicand, Multiplier>>
+{
+  static_assert(Multiplicand::ExactTraits.bits + Multiplier::ExactTraits.bits <= 126,
+                "\n\n\33[1;31mError: The exact value of the expression exceeds 128 bits!\33[0m\n\n");
+
+  static constexpr FixedPrecisionTraits ExactTraits = ProductTraits<Multiplicand::ExactTraits, Multiplier::ExactTraits>();
+  static constexpr int MaxBits = std::min(Multiplicand::MaxBits, Multiplier::MaxBits);
+  static constexpr FixedPrecisionTraits Traits = CappedTraits<ExactTraits, MaxBits>();
+
+  Multiplicand multiplicand;
+  Multiplier multiplier;
+
+  constexpr FusedProduct(Multiplicand const & multiplicand, Multiplier const & multiplier) : multiplicand(multiplicand), multiplier(multiplier) {}
+
+  template <typename Wide>
+  constexpr Wide exact() const { return multiplicand.template exact<Wide>() * multiplier.template exact<Wide>(); }
+};
+
+template <typename Augend, typename Addend, bool difference>
+struct FusedSum : FusedNode<FusedSum<Augend, Addend, difference>>
+{
+  // The width of the exact sum, as SumTraits derives it before holding it in maxBits
+  static constexpr int Power = std::min(Augend::ExactTraits.power, Addend::ExactTraits.power);
+  static constexpr int Top = std::max(Augend::ExactTraits.power + Augend::ExactTraits.bits, Addend::ExactTraits.power + Addend::ExactTraits.bits);
+  static constexpr bool Carry = !difference || Augend::ExactTraits.isSigned || Addend::ExactTraits.isSigned;
+
+  static_assert(Top - Power + Carry <= 126, "\n\n\33[1;31mError: The exact value of the expression exceeds 128 bits!\33[0m\n\n");
+
+  static constexpr FixedPrecisionTraits ExactTraits = SumTraits<Augend::ExactTraits, Addend::ExactTraits, difference>();
+  static constexpr int MaxBits = std::min(Augend::MaxBits, Addend::MaxBits);
+  static constexpr FixedPrecisionTraits Traits = CappedTraits<ExactTraits, MaxBits>();
+
+  Augend augend;
+  Addend addend;
+
+  constexpr FusedSum(Augend const & augend, Addend const & addend) : augend(augend), addend(addend) {}
+
+  template <typename Wide>
+  constexpr Wide exact() const
+  {
+    Wide const lhs = static_cast<Wide>(augend.template exact<Wide>() << (Augend::ExactTraits.power - ExactTraits.power));
+    Wide const rhs = static_cast<Wide>(addend.template exact<Wide>() << (Addend::ExactTraits.power - ExactTraits.power));
+
+    return difference ? lhs - rhs : lhs + rhs;
+  }
+};
+
+template <typename T>
+concept FusedOperand = FusedExpression<T> || FixedPrecisionType<T>;
+
+template <FusedOperand Operand>
+constexpr auto AsFused(Operand const & operand)
+{
+  if constexpr (FusedExpression<Operand>) {
+    return operand;
+  } else {
+    return FusedValue<Operand::Traits>(operand);
+  }
+}
+
+// The operators are found by argument-dependent lookup on their fused operands
+
+template <FusedOperand Multiplicand, FusedOperand Multiplier>
+requires FusedExpression<Multiplicand> || FusedExpression<Multiplier>
+constexpr auto operator*(Multiplicand const & multiplicand, Multiplier const & multiplier)
+{
+  using Lhs = decltype(AsFused(multiplicand));
+  using Rhs = decltype(AsFused(multiplier));
+
+  return FusedProduct<Lhs, Rhs>(AsFused(multiplicand), AsFused(multiplier));
+}
+
+template <FusedOperand Augend, FusedOperand Addend>
+requires FusedExpression<Augend> || FusedExpression<Addend>
+constexpr auto operator+(Augend const & augend, Addend const & addend)
+{
+  using Lhs = decltype(AsFused(augend));
+  using Rhs = decltype(AsFused(addend));
+
+  return FusedSum<Lhs, Rhs, false>(AsFused(augend), AsFused(addend));
+}
+
+template <FusedOperand Minuend, FusedOperand Subtrahend>
+requires FusedExpression<Minuend> || FusedExpression<Subtrahend>
+constexpr auto operator-(Minuend const & minuend, Subtrahend const & subtrahend)
+{
+  using Lhs = decltype(AsFused(minuend));
+  using Rhs = decltype(AsFused(subtrahend));
+
+  return FusedSum<Lhs, Rhs, true>(AsFused(minuend), AsFused(subtrahend));
+}
+
+} // namespace detail
+
+template <FixedPrecisionTraits traits>
+constexpr detail::FusedValue<traits> Fused(FixedPrecision<traits> const value)
+{
+  return detail::FusedValue<traits>(value);
+}
+
+template <detail::FusedExpression Expression>
+constexpr FixedPrecision<Expression::Traits> Evaluate(Expression const & expression)
+{
+  return FixedPrecision<Expression::Traits>(expression);
+}
+
+} // namespace machine
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "fixed-point.hpp"
+#include "fixed-point-array.hpp"
+
+// Sums of products of FixedPrecision arrays, the kernels of FIR filters and small matrix products on Q-format data.
+//
+//   Dot(a, b)                              the sum of a[k] * b[k]
+//   Fir(taps, samples, outputs)            outputs[i] = the sum of taps[k] * samples[i + n - 1 - k], for n taps
+//   Gemv<columns>(m, x, y)                 y[r] = the sum of m[r * columns + k] * x[k]
+//   Gemm<rows, inner, columns>(a, b, c)    c[r * columns + j] = the sum of a[r * inner + k] * b[k * columns + j]
+//
+// Arguments are contiguous ranges of FixedPrecision values, and matrices are stored in row-major order.
+//
+// The sums have AccumulatorTraits: those of a balanced tree of SumTraits over the ProductTraits of the operands,
+// which adds a bit per level, ceil(log2(terms)) bits to the product, and beyond maxBits drops the least significant
+// bits instead.  So the accumulator is sized at compile time from the number of terms, given as a template argument,
+// or by the static extent of an operand (std::array, a C array, or a std::span of static extent).  The sums are
+// computed exactly, then rounded once to the accumulator's power by its rounding policy, and fitted to its bits
+// by its overflow policy, which only the products of the most negative values can exceed.
+//
+// Exact sums of up to 62 bits are computed in 64-bit lanes, 8 per iteration with AVX-512 and 4 with AVX2, by the
+// multiplies of the elementwise kernels (vpmuldq for operands of up to 31 bits).  The pairwise 16-bit multiply-adds
+// (pmaddwd, vpdpwssd) are not used: FastestIntegralType holds data of 8 to 63 bits in 64-bit integers, and narrowing
+// every lane to 16 bits (vpmovqw) costs more than the multiplies it saves.  Dot and Gemv accumulate along the rows,
+// Fir and Gemm across the outputs, each coefficient broadcast to every lane.  Wider sums are computed in 128 bits.
+
+namespace machine {
+
+namespace detail {
+
+// The traits of the sum of terms values of the given traits, added pairwise in a balanced tree
+
+template <FixedPrecisionTraits traits, std::size_t terms>
+constexpr FixedPrecisionTraits TreeSumTraits()
+{
+  if constexpr (terms <= 1) {
+    return traits;
+  } else {
+    return TreeSumTraits<SumTraits<traits, traits>(), (terms + 1) / 2>();
+  }
+}
+
+} // namespace detail
+
+template <FixedPrecisionTraits multiplicandTraits, FixedPrecisionTraits multiplierTraits, std::size_t terms>
+constexpr FixedPrecisionTraits AccumulatorTraits()
+{
+  static_assert(terms > 0, "\n\n\33[1;31mError: An accumulator must hold at least one term!\33[0m\n\n");
+
+  return detail::TreeSumTraits<ProductTraits<multiplicandTraits, multiplierTraits>(), terms>();
+}
+
+template <FixedPrecisionType Multiplicand, FixedPrecisionType Multiplier, std::size_t terms>
+using AccumulatorOf = FixedPrecision<AccumulatorTraits<Multiplicand::Traits, Multiplier::Traits, terms>()>;
+
+namespace detail {
+
+// The number of elements of a std::array, a C array or a std::span of static extent, and 0 for other ranges
+
+template <typename Range>
+constexpr std::size_t StaticExtent = 0;
+
+template <typename T, std::size_t n>
+constexpr std::size_t StaticExtent<std::array<T, n>> = n;
+
+template <typename T, std::size_t n>
+constexpr std::size_t StaticExtent<T[n]> = n;
+
+template <typename T, std::size_t n>
+constexpr std::size_t StaticExtent<std::span<T, n>> = n == std::dynamic_extent ? 0 : n;
+
+template <std::size_t terms, typename Range>
+constexpr std::size_t TermsOf = terms != 0 ? terms : StaticExtent<std::remove_cvref_t<Range>>;
+
+// The exact sum of terms products, whose magnitude is at most 2^ExactSumBits (a product of the most negative values
+// reaches 2^(a.bits + b.bits)), in 64 bits when it fits in 62 and its sign, and in 128 bits otherwise
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b, std::size_t terms>
+constexpr int ExactSumBits = a.bits + b.bits + std::bit_width(terms - 1);
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b, std::size_t terms>
+using ExactSum = std::conditional_t<ExactSumBits<a, b, terms> <= 62, int64_t, __int128>;
+
+// The exact sum rounded to the accumulator's power and fitted to its bits
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b, std::size_t terms>
+constexpr auto RoundSum(ExactSum<a, b, terms> const sum)
+{
+  constexpr FixedPrecisionTraits accumulatorTraits = AccumulatorTraits<a, b, terms>();
+  constexpr int excess = accumulatorTraits.power - (a.power + b.power);
+
+  static_assert(ExactSumBits<a, b, terms> <= 126, "\n\n\33[1;31mError: The exact sum exceeds 128 bits!\33[0m\n\n");
+
+  return Fit<accumulatorTraits>(ShiftRight<accumulatorTraits.rounding, excess>(sum));
+}
+
+// The exact sum of coefficients[k] * operands[k * stride], for k < count
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b, std::size_t terms>
+constexpr ExactSum<a, b, terms> Combine(DataOf<a> const * const coefficients, std::size_t const count,
+                                        DataOf<b> const * const operands, std::ptrdiff_t const stride)
+{
+  using Exact = ExactSum<a, b, terms>;
+
+  Exact sum = 0;
+
+  for (std::size_t k = 0 ; k < count ; ++k) {
+    sum += static_cast<Exact>(coefficients[k]) * static_cast<Exact>(operands[static_cast<std::ptrdiff_t>(k) * stride]);
+  }
+
+  return sum;
+}
+
+// The exact sum of lhs[k] * rhs[k], for k < count, accumulated in lanes when it fits
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b, std::size_t terms>
+ExactSum<a, b, terms> Dot(DataOf<a> const * const lhs, DataOf<b> const * const rhs, std::size_t const count)
+{
+  ExactSum<a, b, terms> sum = 0;
+  std::size_t k = 0;
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+  if constexpr (ExactSumBits<a, b, terms> <= 62) {
+    using Vector = typename Lanes::Vector;
+
+    Vector total = Lanes::Broadcast(0);
+
+    for ( ; k + Lanes::Count <= count ; k += Lanes::Count) {
+      total = Lanes::Add(total, MultiplyVectors<a, b>(Lanes::Load(lhs + k), Lanes::Load(rhs + k)));
+    }
+
+    sum = Lanes::Sum(total);
+  }
+#endif
+
+  return sum + Combine<a, b, terms>(lhs + k, count - k, rhs + k, 1);
+}
+
+// results[j] = the rounded sum of coefficients[k] * operands[j + k * stride], for k < count, a lane per result.
+// Returns the number of results computed, leaving the remainder to Combine.
+
+template <FixedPrecisionTraits a, FixedPrecisionTraits b, std::size_t terms>
+std::size_t CombineLanes([[maybe_unused]] DataOf<a> const * const coefficients,
+                         [[maybe_unused]] std::size_t const count,
+                         [[maybe_unused]] DataOf<b> const * const operands,
+                         [[maybe_unused]] std::ptrdiff_t const stride,
+                         [[maybe_unused]] DataOf<AccumulatorTraits<a, b, terms>()> * const results,
+                         [[maybe_unused]] std::size_t const resultCount)
+{
+  std::size_t j = 0;
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+  if constexpr (ExactSumBits<a, b, terms> <= 62) {
+    using Vector = typename Lanes::Vector;
+
+    for ( ; j + Lanes::Count <= resultCount ; j += Lanes::Count) {
+      Vector sum = Lanes::Broadcast(0);
+
+      for (std::size_t k = 0 ; k < count ; ++k) {
+        Vector const coefficient = Lanes::Broadcast(static_cast<int64_t>(coefficients[k]));
+        sum = Lanes::Add(sum, MultiplyVectors<a, b>(coefficient, Lanes::Load(operands + j + static_cast<std::ptrdiff_t>(k) * stride)));
+      }
+
+      int64_t sums[Lanes::Count];
+      Lanes::Store(sums, sum);
+
+      for (std::size_t lane = 0 ; lane < Lanes::Count ; ++lane) {
+        results[j + lane] = RoundSum<a, b, terms>(sums[lane]);
+      }
+    }
+  }
+#endif
+
+  return j;
+}
+
+} // namespace detail
+
+// The sum of multiplicands[k] * multipliers[k], for the size(multiplicands) terms, of at most terms (by default the
+// static extent of the multiplicands)
+
+template <std::size_t terms = 0, FixedPrecisionRange Multiplicands, FixedPrecisionRange Multipliers>
+auto Dot(Multiplicands const & multiplicands, Multipliers const & multipliers)
+{
+  using Multiplicand = detail::ElementOf<Multiplicands>;
+  using Multiplier = detail::ElementOf<Multipliers>;
+
+  constexpr std::size_t maxTerms = detail::TermsOf<terms, Multiplicands>;
+
+  static_assert(maxTerms != 0, "\n\n\33[1;31mError: The number of terms must be given, as a template argument or by a static extent!\33[0m\n\n");
+
+  std::size_t const count = std::ranges::size(multiplicands);
+  assert(count <= maxTerms && std::ranges::size(multipliers) >= count);
+
+  return AccumulatorOf<Multiplicand, Multiplier, maxTerms>(detail::RoundSum<Multiplicand::Traits, Multiplier::Traits, maxTerms>(
+      detail::Dot<Multiplicand::Traits, Multiplier::Traits, maxTerms>(detail::DataPointer(multiplicands), detail::DataPointer(multipliers), count)));
+}
+
+// outputs[i] = the sum of taps[k] * samples[i + n - 1 - k], for the n = size(taps) taps (at most terms, by default
+// the static extent of the taps), and each of the size(samples) - n + 1 outputs whose samples are all given.
+// A stream is filtered in blocks by carrying the last n - 1 samples of each block to the front of the next.
+
+template <std::size_t terms = 0, FixedPrecisionRange Taps, FixedPrecisionRange Samples, FixedPrecisionRange Outputs>
+void Fir(Taps const & taps, Samples const & samples, Outputs && outputs)
+{
+  using Tap = detail::ElementOf<Taps>;
+  using Sample = detail::ElementOf<Samples>;
+
+  constexpr std::size_t maxTaps = detail::TermsOf<terms, Taps>;
+
+  static_assert(maxTaps != 0, "\n\n\33[1;31mError: The number of taps must be given, as a template argument or by a static extent!\33[0m\n\n");
+  static_assert(std::same_as<detail::ElementOf<Outputs>, AccumulatorOf<Tap, Sample, maxTaps>>,
+                "\n\n\33[1;31mError: The outputs must have the traits of the accumulator of the taps and samples!\33[0m\n\n");
+
+  std::size_t const n = std::ranges::size(taps);
+  assert(n > 0 && n <= maxTaps);
+
+  if (std::ranges::size(samples) < n) return;
+
+  std::size_t const count = std::ranges::size(samples) - n + 1;
+  assert(std::ranges::size(outputs) >= count);
+
+  auto const * const coefficients = detail::DataPointer(taps);
+  auto const * const newest = detail::DataPointer(samples) + (n - 1);
+  auto * const results = detail::DataPointer(outputs);
+
+  std::size_t i = detail::CombineLanes<Tap::Traits, Sample::Traits, maxTaps>(coefficients, n, newest, -1, results, count);
+
+  for ( ; i < count ; ++i) {
+    results[i] = detail::RoundSum<Tap::Traits, Sample::Traits, maxTaps>(
+        detail::Combine<Tap::Traits, Sample::Traits, maxTaps>(coefficients, n, newest + i, -1));
+  }
+}
+
+// results[r] = the sum of matrix[r * columns + k] * vector[k], for each row of the matrix.  columns is by default the
+// static extent of the vector.
+
+template <std::size_t columns = 0, FixedPrecisionRange Matrix, FixedPrecisionRange Vector, FixedPrecisionRange Results>
+void Gemv(Matrix const & matrix, Vector const & vector, Results && results)
+{
+  using Element = detail::ElementOf<Matrix>;
+  using Component = detail::ElementOf<Vector>;
+
+  constexpr std::size_t n = detail::TermsOf<columns, Vector>;
+
+  static_assert(n != 0, "\n\n\33[1;31mError: The number of columns must be given, as a template argument or by a static extent!\33[0m\n\n");
+  static_assert(std::same_as<detail::ElementOf<Results>, AccumulatorOf<Element, Component, n>>,
+                "\n\n\33[1;31mError: The results must have the traits of the accumulator of the operands!\33[0m\n\n");
+
+  std::size_t const rows = std::ranges::size(matrix) / n;
+  assert(std::ranges::size(matrix) == rows * n && std::ranges::size(vector) >= n && std::ranges::size(results) >= rows);
+
+  auto const * const elements = detail::DataPointer(matrix);
+  auto const * const components = detail::DataPointer(vector);
+  auto * const sums = detail::DataPointer(results);
+
+  for (std::size_t r = 0 ; r < rows ; ++r) {
+    sums[r] = detail::RoundSum<Element::Traits, Component::Traits, n>(
+        detail::Dot<Element::Traits, Component::Traits, n>(elements + r * n, components, n));
+  }
+}
+
+// results[r * columns + j] = the sum of lhs[r * inner + k] * rhs[k * columns + j], the product of a rows x inner
+// matrix and an inner x columns matrix
+
+template <std::size_t rows, std::size_t inner, std::size_t columns,
+          FixedPrecisionRange Lhs, FixedPrecisionRange Rhs, FixedPrecisionRange Results>
+void Gemm(Lhs const & lhs, Rhs const & rhs, Results && results)
+{
+  using Multiplicand = detail::ElementOf<Lhs>;
+  using Multiplier = detail::ElementOf<Rhs>;
+
+  static_assert(std::same_as<detail::ElementOf<Results>, AccumulatorOf<Multiplicand, Multiplier, inner>>,
+                "\n\n\33[1;31mError: The results must have the traits of the accumulator of the operands!\33[0m\n\n");
+
+  assert(std::ranges::size(lhs) >= rows * inner && std::ranges::size(rhs) >= inner * columns &&
+         std::ranges::size(results) >= rows * columns);
+
+  auto const * const multiplicands = detail::DataPointer(lhs);
+  auto const * const multipliers = detail::DataPointer(rhs);
+  auto * const sums = detail::DataPointer(results);
+
+  for (std::size_t r = 0 ; r < rows ; ++r) {
+    auto const * const row = multiplicands + r * inner;
+    auto * const output = sums + r * columns;
+
+    std::size_t const lanes = detail::CombineLanes<Multiplicand::Traits, Multiplier::Traits, inner>(row, inner, multipliers, columns, output, columns);
+
+    for (std::size_t k = 0 ; k < columns - lanes ; ++k) {
+      std::size_t const j = lanes + k;
+      output[j] = detail::RoundSum<Multiplicand::Traits, Multiplier::Traits, inner>(
+          detail::Combine<Multiplicand::Traits, Multiplier::Traits, inner>(row, inner, multipliers + j, columns));
+    }
+  }
+}
+
+} // namespace machine
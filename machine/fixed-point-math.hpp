@@ -0,0 +1,754 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "fixed-point.hpp"
+#include "fixed-point-array.hpp"
+
+// Elementary functions of FixedPrecision values, computed in integer arithmetic, without a floating point round trip.
+//
+//   SinCos, Sin, Cos     The angle (in radians) is reduced to r in [-pi/4, pi/4] by a multiply by 2/pi.  sin and cos
+//                        of r are those of the nearest j/128, from a table, rotated by degree 7 and 6 polynomials
+//                        of the remainder.
+//   Atan2                CORDIC vectoring, of the operands aligned to a common power and normalized to 60 bits, for
+//                        as many iterations as the result's fractional bits need
+//   Exp                  2^(x log2(e)): 2^(j/256) from a table, times a degree 6 polynomial of the remainder
+//   Log2                 The exponent, plus log2(1/R_j) from a table, plus a degree 8 polynomial of m R_j - 1,
+//                        where R_j is a reciprocal of the normalized mantissa m, from a table indexed by its top bits
+//   Sqrt                 The exact root: 1/sqrt from a table, three Newton iterations, and a correction by the residual
+//
+// Every constant and table (2/pi, sin and cos of j/128, the CORDIC angles, 2^(j/256), R_j, log2(1/R_j), 1/sqrt) is
+// generated at compile time from series evaluated in 128-bit arithmetic with 120 fractional bits, then rounded to the
+// 62 fractional bits of the working precision.
+//
+// The result traits are a template argument, defaulting to the formats below.  Results are rounded to them by their
+// rounding policy and fitted to them by their overflow policy; with round to nearest, they are within 1 unit in the
+// last place (ulp) of the exact value for results of up to 56 fractional bits.  The reduction of sin and cos holds
+// 2/pi to 64 bits, so its error grows as |angle| * 2^-64.
+//
+// Batch variants take contiguous ranges of operands and of results, whose element type gives the result traits.
+
+namespace machine {
+
+// Default result traits: sin and cos in [-1, 1], angles in [-pi, pi], and logarithms in [-256, 256)
+
+constexpr FixedPrecisionTraits UnitTraits = {.isSigned = true, .bits = 31, .power = -30, .rounding = RoundingPolicy::Nearest};
+constexpr FixedPrecisionTraits AngleTraits = {.isSigned = true, .bits = 31, .power = -29, .rounding = RoundingPolicy::Nearest};
+constexpr FixedPrecisionTraits LogarithmTraits = {.isSigned = true, .bits = 31, .power = -23, .rounding = RoundingPolicy::Nearest};
+constexpr FixedPrecisionTraits ExponentialTraits = {.isSigned = false, .bits = 32, .power = -16, .rounding = RoundingPolicy::Nearest,
+                                                    .overflow = OverflowPolicy::Saturate};
+
+// The square root keeps the operand's bits (up to 62), with the power that fits its root
+
+template <FixedPrecisionTraits traits>
+constexpr FixedPrecisionTraits SqrtTraits()
+{
+  constexpr int bits = std::min(traits.bits, 62);
+  constexpr int top = traits.power + traits.bits;
+
+  return {
+    .isSigned = false,
+    .bits = bits,
+    .power = ((top + 1) >> 1) - bits,
+    .minBits = std::min(traits.minBits, bits),
+    .maxBits = std::max(bits, std::min(traits.maxBits, 64)),
+    .rounding = traits.rounding,
+    .overflow = traits.overflow};
+}
+
+namespace detail {
+
+// Compile-time arithmetic on unsigned 128-bit values with 120 fractional bits
+
+using Wide120 = unsigned __int128;
+
+constexpr int Fraction120 = 120;
+constexpr Wide120 One120 = Wide120(1) << Fraction120;
+
+// lhs * rhs, rounded down, for values below 2^127
+
+constexpr Wide120 Multiply120(Wide120 const lhs, Wide120 const rhs)
+{
+  uint64_t const lhsHigh = static_cast<uint64_t>(lhs >> 64), lhsLow = static_cast<uint64_t>(lhs);
+  uint64_t const rhsHigh = static_cast<uint64_t>(rhs >> 64), rhsLow = static_cast<uint64_t>(rhs);
+
+  Wide120 const low = Wide120(lhsLow) * rhsLow;
+  Wide120 const crossA = Wide120(lhsLow) * rhsHigh;
+  Wide120 const crossB = Wide120(lhsHigh) * rhsLow;
+  Wide120 const high = Wide120(lhsHigh) * rhsHigh;
+
+  // The 256-bit product is top:bottom
+  Wide120 const middle = (low >> 64) + static_cast<uint64_t>(crossA) + static_cast<uint64_t>(crossB);
+  Wide120 const top = high + (crossA >> 64) + (crossB >> 64) + (middle >> 64);
+  Wide120 const bottom = (middle << 64) | static_cast<uint64_t>(low);
+
+  return (top << (128 - Fraction120)) | (bottom >> Fraction120);
+}
+
+// dividend / divisor, rounded down, by long division, for divisors below 2^126
+
+constexpr Wide120 Divide120(Wide120 const dividend, Wide120 const divisor)
+{
+  Wide120 quotient = 0;
+  Wide120 remainder = 0;
+
+  for (int bit = 127 + Fraction120 ; bit >= 0 ; --bit) {
+    remainder = (remainder << 1) | (bit >= Fraction120 ? (dividend >> (bit - Fraction120)) & 1 : 0);
+    quotient <<= 1;
+
+    if (remainder >= divisor) {
+      remainder -= divisor;
+      quotient |= 1;
+    }
+  }
+
+  return quotient;
+}
+
+// atan(1 / n), and atan(2^-shift) for shift >= 1, by their Taylor series
+
+constexpr Wide120 AtanOfInverse120(uint64_t const n)
+{
+  Wide120 sum = 0;
+  Wide120 power = One120 / n;
+
+  for (uint64_t k = 1 ; power != 0 ; k += 2) {
+    sum = (k % 4 == 1) ? sum + power / k : sum - power / k;
+    power /= n * n;
+  }
+
+  return sum;
+}
+
+constexpr Wide120 AtanOfPowerOfTwo120(int const shift)
+{
+  Wide120 sum = 0;
+  Wide120 power = One120 >> shift;
+
+  for (uint64_t k = 1 ; power != 0 ; k += 2) {
+    sum = (k % 4 == 1) ? sum + power / k : sum - power / k;
+    power = 2 * shift < Fraction120 ? power >> (2 * shift) : 0;
+  }
+
+  return sum;
+}
+
+// Machin's formula
+constexpr Wide120 Pi120 = 4 * (4 * AtanOfInverse120(5) - AtanOfInverse120(239));
+
+// ln(2) = sum 1 / (k 2^k)
+constexpr Wide120 Ln2_120 = [] {
+  Wide120 sum = 0;
+  for (int k = 1 ; k < Fraction120 ; ++k) sum += (One120 >> k) / k;
+  return sum;
+}();
+
+// e^value, for value in [0, 1)
+
+constexpr Wide120 Exp120(Wide120 const value)
+{
+  Wide120 sum = One120;
+  Wide120 term = One120;
+
+  for (uint64_t k = 1 ; term != 0 ; ++k) {
+    term = Multiply120(term, value) / k;
+    sum += term;
+  }
+
+  return sum;
+}
+
+// sin(value) and cos(value), for value in [0, 1)
+
+constexpr std::pair<Wide120, Wide120> SinCos120(Wide120 const value)
+{
+  Wide120 sine = 0;
+  Wide120 cosine = 0;
+  Wide120 term = One120;
+
+  // term is value^k / k!, whose sign cycles with k
+  for (uint64_t k = 0 ; term != 0 ; ++k) {
+    switch (k % 4) {
+    case 0: cosine += term; break;
+    case 1: sine += term; break;
+    case 2: cosine -= term; break;
+    case 3: sine -= term; break;
+    }
+
+    term = Multiply120(term, value) / (k + 1);
+  }
+
+  return {sine, cosine};
+}
+
+// ln(value), for value in [1, 2], as 2 atanh((value - 1) / (value + 1))
+
+constexpr Wide120 Ln120(Wide120 const value)
+{
+  Wide120 const ratio = Divide120(value - One120, value + One120);
+  Wide120 const square = Multiply120(ratio, ratio);
+
+  Wide120 sum = 0;
+  Wide120 power = ratio;
+
+  for (uint64_t k = 1 ; power != 0 ; k += 2) {
+    sum += power / k;
+    power = Multiply120(power, square);
+  }
+
+  return 2 * sum;
+}
+
+// Rounded to [fraction] fractional bits
+
+template <int fraction>
+constexpr uint64_t Round120(Wide120 const value)
+{
+  return static_cast<uint64_t>((value + (Wide120(1) << (Fraction120 - fraction - 1))) >> (Fraction120 - fraction));
+}
+
+// The working precision: Q1.62
+
+constexpr int WorkingFraction = 62;
+constexpr FixedPrecisionTraits WorkingTraits = {.isSigned = true, .bits = 63, .power = -WorkingFraction};
+
+constexpr int64_t Multiply62(int64_t const lhs, int64_t const rhs)
+{
+  return static_cast<int64_t>((static_cast<__int128>(lhs) * rhs) >> WorkingFraction);
+}
+
+constexpr int64_t PiOver2_62 = static_cast<int64_t>(Round120<62>(Pi120 / 2));
+constexpr int64_t Pi_61 = static_cast<int64_t>(Round120<61>(Pi120));
+constexpr uint64_t TwoOverPi_64 = Round120<64>(Divide120(2 * One120, Pi120));
+constexpr int64_t Log2e_62 = static_cast<int64_t>(Round120<62>(Divide120(One120, Ln2_120)));
+constexpr int64_t Ln2_62 = static_cast<int64_t>(Round120<62>(Ln2_120));
+
+// CORDIC: the angles atan(2^-i)
+
+constexpr int CordicIterations = 62;
+
+inline constexpr std::array<int64_t, CordicIterations> CordicAngles = [] {
+  std::array<int64_t, CordicIterations> angles{};
+
+  angles[0] = static_cast<int64_t>(Round120<62>(Pi120 / 4));
+
+  for (int i = 1 ; i < CordicIterations ; ++i) {
+    angles[i] = static_cast<int64_t>(Round120<62>(AtanOfPowerOfTwo120(i)));
+  }
+
+  return angles;
+}();
+
+// Iterations for a result with the traits' fractional bits, which leave an angle residual below 1/8 ulp
+
+template <FixedPrecisionTraits traits>
+constexpr int CordicIterationsFor = std::clamp(4 - traits.power, 1, CordicIterations);
+
+// value, negated when mask is all ones, e.g. the sign of a negative value
+
+constexpr int64_t NegateIf(int64_t const value, int64_t const mask)
+{
+  return (value ^ mask) - mask;
+}
+
+// SinCos: sin and cos of j/128, for j/128 up to pi/4
+
+constexpr int SinCosTableBits = 7;
+constexpr std::size_t SinCosTableSize = 102;
+
+inline constexpr std::array<std::pair<int64_t, int64_t>, SinCosTableSize> SinCosTable = [] {
+  std::array<std::pair<int64_t, int64_t>, SinCosTableSize> table{};
+
+  for (std::size_t j = 0 ; j < table.size() ; ++j) {
+    auto const [sine, cosine] = SinCos120((One120 >> SinCosTableBits) * j);
+    table[j] = {static_cast<int64_t>(Round120<62>(sine)), static_cast<int64_t>(Round120<62>(cosine))};
+  }
+
+  return table;
+}();
+
+// Exp: 2^(j/256).  1/k! are the coefficients of e^u, and of sin and cos.
+
+constexpr int ExpTableBits = 8;
+
+inline constexpr std::array<int64_t, 1 << ExpTableBits> Exp2Table = [] {
+  std::array<int64_t, 1 << ExpTableBits> table{};
+
+  for (std::size_t j = 0 ; j < table.size() ; ++j) {
+    table[j] = static_cast<int64_t>(Round120<62>(Exp120(Multiply120(Ln2_120, (One120 >> ExpTableBits) * j))));
+  }
+
+  return table;
+}();
+
+inline constexpr std::array<int64_t, 8> InverseFactorials = [] {
+  std::array<int64_t, 8> coefficients{};
+  Wide120 term = One120;
+
+  for (std::size_t k = 0 ; k < coefficients.size() ; ++k) {
+    if (k > 0) term /= k;
+    coefficients[k] = static_cast<int64_t>(Round120<62>(term));
+  }
+
+  return coefficients;
+}();
+
+// Log2: the reciprocals R_j of the midpoints of [1 + j/256, 1 + (j + 1)/256), as 0.64 fractions,
+// and log2(1 / R_j) of each rounded reciprocal
+
+constexpr int LogTableBits = 8;
+
+inline constexpr std::array<uint64_t, 1 << LogTableBits> LogReciprocals = [] {
+  std::array<uint64_t, 1 << LogTableBits> table{};
+
+  for (std::size_t j = 0 ; j < table.size() ; ++j) {
+    Wide120 const midpoint = One120 + (One120 >> (LogTableBits + 1)) * (2 * j + 1);
+    table[j] = Round120<64>(Divide120(One120, midpoint));
+  }
+
+  return table;
+}();
+
+inline constexpr std::array<int64_t, 1 << LogTableBits> LogTable = [] {
+  std::array<int64_t, 1 << LogTableBits> table{};
+
+  for (std::size_t j = 0 ; j < table.size() ; ++j) {
+    Wide120 const reciprocal = Wide120(LogReciprocals[j]) << (Fraction120 - 64);
+    table[j] = static_cast<int64_t>(Round120<62>(Divide120(Ln120(Divide120(One120, reciprocal)), Ln2_120)));
+  }
+
+  return table;
+}();
+
+// 1/k, the coefficients of ln(1 + r)
+
+inline constexpr std::array<int64_t, 9> InverseIntegers = [] {
+  std::array<int64_t, 9> coefficients{};
+
+  for (std::size_t k = 1 ; k < coefficients.size() ; ++k) {
+    coefficients[k] = static_cast<int64_t>(Round120<62>(One120 / k));
+  }
+
+  return coefficients;
+}();
+
+// Sqrt: 1/sqrt((j + 1/2) / 256), for the top 8 bits j of a value normalized to [2^62, 2^64)
+
+inline constexpr std::array<uint64_t, 256> ReciprocalSquareRoots = [] {
+  std::array<uint64_t, 256> table{};
+
+  for (std::size_t j = 64 ; j < table.size() ; ++j) {
+    // 2^62 sqrt(512 / (2j + 1)), to 59 bits, as the bitwise root of 2^127 / (2j + 1)
+    Wide120 remainder = (Wide120(1) << 127) / (2 * j + 1);
+    Wide120 root = 0;
+
+    for (Wide120 bit = Wide120(1) << 126 ; bit != 0 ; bit >>= 2) {
+      if (remainder >= root + bit) {
+        remainder -= root + bit;
+        root = (root >> 1) + bit;
+      } else {
+        root >>= 1;
+      }
+    }
+
+    table[j] = static_cast<uint64_t>(root << 3);
+  }
+
+  return table;
+}();
+
+// value / 2^shift, for a shift known at run time, rounded according to rounding
+
+template <RoundingPolicy rounding>
+constexpr uint64_t ShiftRightBy(uint64_t const value, int const shift)
+{
+  if (shift >= 64) return 0;
+  if (shift <= 0) return value;
+
+  uint64_t const floor = value >> shift;
+  uint64_t const remainder = value & ((uint64_t(1) << shift) - 1);
+  uint64_t const half = uint64_t(1) << (shift - 1);
+
+  if constexpr (rounding == RoundingPolicy::Truncate) {
+    return floor;
+  } else if constexpr (rounding == RoundingPolicy::Nearest) {
+    return floor + (remainder >= half);
+  } else {
+    return floor + (remainder > half || (remainder == half && (floor & 1) != 0));
+  }
+}
+
+// floor(sqrt(value))
+
+constexpr uint64_t SquareRoot(unsigned __int128 const value)
+{
+  if (value == 0) return 0;
+
+  // Normalized to [2^126, 2^128) by an even shift, whose top 64 bits are top = m 2^64, with m in [1/4, 1)
+
+  int const shift = (128 - BitWidth128(value)) & ~1;
+  unsigned __int128 const normalized = value << shift;
+  uint64_t const top = static_cast<uint64_t>(normalized >> 64);
+
+  // x = 1/sqrt(m), as a Q2.62, by Newton's iteration x (3 - m x^2) / 2, from 8 bits to the working precision.
+  // The iteration never exceeds 1/sqrt(m), which is at most 2, so x^2 stays below 4.
+
+  uint64_t x = ReciprocalSquareRoots[top >> 56];
+
+  for (int i = 0 ; i < 3 ; ++i) {
+    uint64_t const square = static_cast<uint64_t>((static_cast<unsigned __int128>(x) * x) >> 62);
+    uint64_t const product = static_cast<uint64_t>((static_cast<unsigned __int128>(top) * square) >> 64);
+
+    x = static_cast<uint64_t>((static_cast<unsigned __int128>(x) * ((uint64_t(3) << 62) - product)) >> 63);
+  }
+
+  // root = m x 2^64, corrected by (normalized - root^2) / (2 root), then to the exact floor
+
+  unsigned __int128 root = (static_cast<unsigned __int128>(top) * x) >> 62;
+
+  __int128 const residual = static_cast<__int128>(normalized - root * root);
+  root += static_cast<unsigned __int128>(((residual >> 40) * static_cast<__int128>(x)) >> 87);
+
+  while (root >> 64 != 0 || root * root > normalized) --root;
+  while (root < UINT64_MAX && (root + 1) * (root + 1) <= normalized) ++root;
+
+  return static_cast<uint64_t>(root >> (shift / 2));
+}
+
+// sin and cos of angle * 2^power, in Q1.62
+
+template <FixedPrecisionTraits traits>
+constexpr std::pair<int64_t, int64_t> SinCos62(decltype(FastestIntegralType<traits>()) const angle)
+{
+  // angle * 2/pi = product * 2^(power - 64), whose binary point is at bit 64 - power of the product.
+  // Its residue modulo 4, as a Q2.62, holds the quadrant and the reduced angle.
+
+  constexpr int point = 64 - traits.power;
+
+  static_assert(point - WorkingFraction < 128, "\n\n\33[1;31mError: The angle's power is below the range of the reduction!\33[0m\n\n");
+  static_assert(sizeof(angle) <= sizeof(uint64_t), "\n\n\33[1;31mError: The reduction takes angles of up to 64 bits!\33[0m\n\n");
+
+  __int128 const product = static_cast<__int128>(angle) * static_cast<__int128>(TwoOverPi_64);
+
+  uint64_t residue;
+
+  if constexpr (point >= WorkingFraction) {
+    residue = static_cast<uint64_t>(static_cast<unsigned __int128>(product >> (point - WorkingFraction)));
+  } else if constexpr (WorkingFraction - point < 64) {
+    residue = static_cast<uint64_t>(static_cast<unsigned __int128>(product)) << (WorkingFraction - point);
+  } else {
+    residue = 0;
+  }
+
+  uint64_t const quadrant = (residue + (uint64_t(1) << (WorkingFraction - 1))) >> WorkingFraction;
+  int64_t const fraction = static_cast<int64_t>(residue - (quadrant << WorkingFraction));
+
+  // sin and cos of |r| = j/128 + d, with |d| <= 1/256, from those of j/128 and of d
+
+  int64_t const r = Multiply62(fraction, PiOver2_62);
+  int64_t const sign = r >> 63;
+  int64_t const magnitude = NegateIf(r, sign);
+
+  constexpr int indexShift = WorkingFraction - SinCosTableBits;
+
+  int64_t const j = (magnitude + (int64_t(1) << (indexShift - 1))) >> indexShift;
+  int64_t const d = magnitude - (j << indexShift);
+  int64_t const d2 = Multiply62(d, d);
+
+  // sin(d) = d - d^3 (1/3! - d^2 (1/5! - d^2/7!)), and cos(d) = 1 - d^2 (1/2! - d^2 (1/4! - d^2/6!))
+
+  int64_t const sinD = d - Multiply62(Multiply62(d, d2),
+                                      InverseFactorials[3] - Multiply62(d2, InverseFactorials[5] - Multiply62(d2, InverseFactorials[7])));
+  int64_t const cosD = InverseFactorials[0] - Multiply62(d2, InverseFactorials[2] - Multiply62(d2, InverseFactorials[4] -
+                                                                                                    Multiply62(d2, InverseFactorials[6])));
+
+  auto const [sinJ, cosJ] = SinCosTable[j];
+
+  int64_t const y = NegateIf(Multiply62(sinJ, cosD) + Multiply62(cosJ, sinD), sign);
+  int64_t const x = Multiply62(cosJ, cosD) - Multiply62(sinJ, sinD);
+
+  // sin and cos of the quadrant's multiple of pi/2 plus the reduced angle
+
+  bool const swap = (quadrant & 1) != 0;
+  int64_t const sine = swap ? x : y;
+  int64_t const cosine = swap ? y : x;
+
+  return {(quadrant & 2) != 0 ? -sine : sine, ((quadrant + 1) & 2) != 0 ? -cosine : cosine};
+}
+
+template <typename Operands, typename Results, typename Function>
+void Transform(Operands const & operands, Results && results, Function const & function)
+{
+  std::size_t const count = std::ranges::size(operands);
+  assert(std::ranges::size(results) >= count);
+
+  for (std::size_t i = 0 ; i < count ; ++i) {
+    std::ranges::data(results)[i] = function(std::ranges::data(operands)[i]);
+  }
+}
+
+} // namespace detail
+
+// sin and cos of an angle in radians
+
+template <FixedPrecisionTraits resultTraits = UnitTraits, FixedPrecisionTraits traits>
+std::pair<FixedPrecision<resultTraits>, FixedPrecision<resultTraits>> SinCos(FixedPrecision<traits> const angle)
+{
+  using Result = FixedPrecision<resultTraits>;
+  using Working = FixedPrecision<detail::WorkingTraits>;
+
+  auto const [sine, cosine] = detail::SinCos62<traits>(angle.data);
+
+  return {Result::FromFixed(Working(sine)), Result::FromFixed(Working(cosine))};
+}
+
+template <FixedPrecisionTraits resultTraits = UnitTraits, FixedPrecisionTraits traits>
+FixedPrecision<resultTraits> Sin(FixedPrecision<traits> const angle)
+{
+  return SinCos<resultTraits>(angle).first;
+}
+
+template <FixedPrecisionTraits resultTraits = UnitTraits, FixedPrecisionTraits traits>
+FixedPrecision<resultTraits> Cos(FixedPrecision<traits> const angle)
+{
+  return SinCos<resultTraits>(angle).second;
+}
+
+// The angle of (x, y), in [-pi, pi].  Atan2(0, 0) is 0.
+
+template <FixedPrecisionTraits resultTraits = AngleTraits, FixedPrecisionTraits yTraits, FixedPrecisionTraits xTraits>
+FixedPrecision<resultTraits> Atan2(FixedPrecision<yTraits> const y, FixedPrecision<xTraits> const x)
+{
+  constexpr int power = std::min(yTraits.power, xTraits.power);
+  constexpr int iterations = detail::CordicIterationsFor<resultTraits>;
+
+  static_assert(yTraits.bits + yTraits.power - power <= 126 && xTraits.bits + xTraits.power - power <= 126,
+                "\n\n\33[1;31mError: The aligned operands exceed 128 bits!\33[0m\n\n");
+
+  // Aligned to a common power, then normalized to 60 bits, which leaves room for the CORDIC growth
+
+  __int128 wideY = static_cast<__int128>(y.data) << (yTraits.power - power);
+  __int128 wideX = static_cast<__int128>(x.data) << (xTraits.power - power);
+
+  unsigned __int128 const magnitude = std::max(static_cast<unsigned __int128>(wideY < 0 ? -wideY : wideY),
+                                               static_cast<unsigned __int128>(wideX < 0 ? -wideX : wideX));
+
+  int const shift = detail::BitWidth128(magnitude) - 60;
+
+  wideY = shift > 0 ? wideY >> shift : wideY << -shift;
+  wideX = shift > 0 ? wideX >> shift : wideX << -shift;
+
+  // For x < 0, (x, y) is rotated by pi, and pi, signed as y, is added to the angle
+
+  int64_t const negative = static_cast<int64_t>(wideX >> 127);
+
+  int64_t vectorX = detail::NegateIf(static_cast<int64_t>(wideX), negative);
+  int64_t vectorY = detail::NegateIf(static_cast<int64_t>(wideY), negative);
+  int64_t const base = negative & (y.data < 0 ? -detail::Pi_61 : detail::Pi_61);
+
+  // Rotate (x, y) onto the x axis, accumulating the angle
+
+  int64_t z = 0;
+
+  for (int i = 0 ; i < iterations ; ++i) {
+    int64_t const direction = vectorY >> 63;
+    int64_t const nextX = vectorX + detail::NegateIf(vectorY >> i, direction);
+
+    vectorY -= detail::NegateIf(vectorX >> i, direction);
+    vectorX = nextX;
+    z += detail::NegateIf(detail::CordicAngles[i], direction);
+  }
+
+  int64_t const angle = magnitude == 0 ? 0 : (z >> 1) + base;
+
+  return FixedPrecision<resultTraits>::FromFixed(FixedPrecision<{.isSigned = true, .bits = 63, .power = -61}>(angle));
+}
+
+// e^x
+
+template <FixedPrecisionTraits resultTraits = ExponentialTraits, FixedPrecisionTraits traits>
+FixedPrecision<resultTraits> Exp(FixedPrecision<traits> const x)
+{
+  constexpr int point = detail::WorkingFraction - traits.power;
+  constexpr uint64_t FractionMask = (uint64_t(1) << detail::WorkingFraction) - 1;
+
+  static_assert(point >= 0 && point < 128, "\n\n\33[1;31mError: The operand's power is beyond the range of Exp!\33[0m\n\n");
+  static_assert(sizeof(x.data) <= sizeof(uint64_t), "\n\n\33[1;31mError: Exp takes operands of up to 64 bits!\33[0m\n\n");
+
+  // x log2(e) = product * 2^-point = n + f, with f in [0, 1) as a 0.62 fraction
+
+  __int128 const product = static_cast<__int128>(x.data) * detail::Log2e_62;
+  __int128 const integral = product >> point;
+  uint64_t fraction;
+
+  if constexpr (point >= detail::WorkingFraction) {
+    fraction = static_cast<uint64_t>(static_cast<unsigned __int128>(product >> (point - detail::WorkingFraction))) & FractionMask;
+  } else {
+    fraction = (static_cast<uint64_t>(static_cast<unsigned __int128>(product)) << (detail::WorkingFraction - point)) & FractionMask;
+  }
+
+  // 2^f = 2^(j/256) e^u, with u = (f - j/256) ln(2) below 2^-8
+
+  constexpr int indexShift = detail::WorkingFraction - detail::ExpTableBits;
+
+  uint64_t const index = fraction >> indexShift;
+  int64_t const u = detail::Multiply62(static_cast<int64_t>(fraction & ((uint64_t(1) << indexShift) - 1)), detail::Ln2_62);
+
+  int64_t series = detail::InverseFactorials[6];
+
+  for (int k = 5 ; k >= 0 ; --k) {
+    series = detail::InverseFactorials[k] + detail::Multiply62(series, u);
+  }
+
+  uint64_t const power2 = static_cast<uint64_t>(detail::Multiply62(detail::Exp2Table[index], series));
+
+  // 2^n 2^f in units of the result: a left shift only overflows, so is bounded to 64 bits, and a right shift rounds
+
+  int const exponent = static_cast<int>(std::clamp<__int128>(integral, -4096, 4096)) - detail::WorkingFraction - resultTraits.power;
+
+  __int128 const value = exponent >= 0 ? static_cast<__int128>(power2) << std::min(exponent, 64)
+                                       : static_cast<__int128>(detail::ShiftRightBy<resultTraits.rounding>(power2, -exponent));
+
+  return FixedPrecision<resultTraits>(detail::Fit<resultTraits>(value));
+}
+
+// log2(x).  Values <= 0 give MinData, or trap with the Trap policy.
+
+template <FixedPrecisionTraits resultTraits = LogarithmTraits, FixedPrecisionTraits traits>
+FixedPrecision<resultTraits> Log2(FixedPrecision<traits> const x)
+{
+  using Result = FixedPrecision<resultTraits>;
+
+  constexpr int shift = resultTraits.power + detail::WorkingFraction;
+
+  static_assert(shift > -56, "\n\n\33[1;31mError: Log2 results have at most 117 fractional bits!\33[0m\n\n");
+
+  if (!(x.data > 0)) {
+    if constexpr (resultTraits.overflow == OverflowPolicy::Trap) __builtin_trap();
+    return Result(Result::MinData);
+  }
+
+  // x = m 2^(exponent + power), with m in [1, 2) as a 1.63 fraction, of the top 64 bits of data of up to 128
+
+  unsigned __int128 const data = static_cast<unsigned __int128>(x.data);
+  int const exponent = detail::BitWidth128(data) - 1;
+  uint64_t const mantissa = exponent > 63 ? static_cast<uint64_t>(data >> (exponent - 63)) : static_cast<uint64_t>(data) << (63 - exponent);
+
+  // m R_j = 1 + r, with |r| < 2^-9
+
+  uint64_t const index = (mantissa >> (63 - detail::LogTableBits)) & ((uint64_t(1) << detail::LogTableBits) - 1);
+  uint64_t const scaled = static_cast<uint64_t>((static_cast<unsigned __int128>(mantissa) * detail::LogReciprocals[index]) >> 64);
+  int64_t const r = static_cast<int64_t>(scaled - (uint64_t(1) << 63)) >> 1;
+
+  // ln(1 + r) = r (1 - r (1/2 - r (1/3 - ...)))
+
+  int64_t series = detail::InverseIntegers[8];
+
+  for (int k = 7 ; k >= 1 ; --k) {
+    series = detail::InverseIntegers[k] - detail::Multiply62(series, r);
+  }
+
+  int64_t const logarithm = detail::Multiply62(detail::Multiply62(series, r), detail::Log2e_62);
+
+  __int128 const total = (static_cast<__int128>(exponent + traits.power) << detail::WorkingFraction) + detail::LogTable[index] + logarithm;
+
+  if constexpr (shift >= 0) {
+    return Result(detail::Fit<resultTraits>(detail::ShiftRight<resultTraits.rounding, shift>(total)));
+  } else {
+    return Result(detail::Fit<resultTraits>(total << -shift));
+  }
+}
+
+// sqrt(x), in SqrtTraits<traits>() unless given result traits.  Negative values give 0, or trap with the Trap policy.
+
+template <FixedPrecisionTraits requestedTraits = FixedPrecisionTraits{}, FixedPrecisionTraits traits,
+          FixedPrecisionTraits resultTraits = requestedTraits.bits == 0 ? SqrtTraits<traits>() : requestedTraits>
+FixedPrecision<resultTraits> Sqrt(FixedPrecision<traits> const x)
+{
+  // root * 2^power = sqrt(data * 2^traits.power), so 2 root = sqrt(data * 2^(traits.power - 2 power + 2))
+  constexpr int shift = traits.power - 2 * resultTraits.power + 2;
+
+  static_assert(traits.bits + shift <= 128, "\n\n\33[1;31mError: The square root exceeds 64 bits!\33[0m\n\n");
+
+  if constexpr (traits.isSigned) {
+    if (x.data < 0) {
+      if constexpr (resultTraits.overflow == OverflowPolicy::Trap) __builtin_trap();
+      return FixedPrecision<resultTraits>(0);
+    }
+  }
+
+  unsigned __int128 const data = static_cast<unsigned __int128>(x.data);
+  unsigned __int128 scaled;
+
+  if constexpr (shift >= 0) {
+    scaled = data << shift;
+  } else if constexpr (-shift < 128) {
+    scaled = data >> -shift;
+  } else {
+    scaled = 0;
+  }
+
+  // The root is never a half integer, so Nearest and Convergent agree
+  uint64_t const twice = detail::SquareRoot(scaled);
+  uint64_t const root = resultTraits.rounding == RoundingPolicy::Truncate ? twice >> 1 : (twice >> 1) + (twice & 1);
+
+  return FixedPrecision<resultTraits>(detail::Fit<resultTraits>(root));
+}
+
+// Batch variants: results[i] = f(operands[i]), in the traits of the results
+
+template <FixedPrecisionRange Angles, FixedPrecisionRange Results>
+void Sin(Angles const & angles, Results && results)
+{
+  detail::Transform(angles, results, [](auto const angle) { return Sin<detail::ElementOf<Results>::Traits>(angle); });
+}
+
+template <FixedPrecisionRange Angles, FixedPrecisionRange Results>
+void Cos(Angles const & angles, Results && results)
+{
+  detail::Transform(angles, results, [](auto const angle) { return Cos<detail::ElementOf<Results>::Traits>(angle); });
+}
+
+template <FixedPrecisionRange Operands, FixedPrecisionRange Results>
+void Exp(Operands const & operands, Results && results)
+{
+  detail::Transform(operands, results, [](auto const x) { return Exp<detail::ElementOf<Results>::Traits>(x); });
+}
+
+template <FixedPrecisionRange Operands, FixedPrecisionRange Results>
+void Log2(Operands const & operands, Results && results)
+{
+  detail::Transform(operands, results, [](auto const x) { return Log2<detail::ElementOf<Results>::Traits>(x); });
+}
+
+template <FixedPrecisionRange Operands, FixedPrecisionRange Results>
+void Sqrt(Operands const & operands, Results && results)
+{
+  detail::Transform(operands, results, [](auto const x) { return Sqrt<detail::ElementOf<Results>::Traits>(x); });
+}
+
+// angles[i] = Atan2(ys[i], xs[i])
+
+template <FixedPrecisionRange Ys, FixedPrecisionRange Xs, FixedPrecisionRange Angles>
+void Atan2(Ys const & ys, Xs const & xs, Angles && angles)
+{
+  using Angle = detail::ElementOf<Angles>;
+
+  std::size_t const count = std::ranges::size(ys);
+  assert(std::ranges::size(xs) >= count && std::ranges::size(angles) >= count);
+
+  for (std::size_t i = 0 ; i < count ; ++i) {
+    std::ranges::data(angles)[i] = Atan2<Angle::Traits>(std::ranges::data(ys)[i], std::ranges::data(xs)[i]);
+  }
+}
+
+} // namespace machine
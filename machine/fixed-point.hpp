@@ -1,7 +1,8 @@
 #pragma once
 
-#include <iostream>
-
+#include <cmath>
+#include <concepts>
+#include <climits>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
@@ -9,9 +10,15 @@
 #include <algorithm>
 #include <variant>
 #include <bit>
+#include <compare>
+#include <utility>
 
 #include <cassert>
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 #include "ieee754_types.hpp"
 
 #include "ieee754.h"
@@ -87,6 +94,24 @@ using NumericTraits = uint32_t;
 
 constexpr NumericTraits SIGNED = 0x00000001;
 
+// Rounding and overflow policies, of arithmetic results and conversions whose bits do not fit their traits.
+// Each is ordered from the least to the most strict, and the result of an operation takes the stricter of
+// its operands' policies.
+
+enum class RoundingPolicy
+{
+  Truncate,   // Towards zero
+  Nearest,    // To nearest, ties away from zero
+  Convergent  // To nearest, ties to even
+};
+
+enum class OverflowPolicy
+{
+  Wrap,       // As the underlying integral wraps
+  Saturate,   // To the nearest value the traits' bits can hold
+  Trap        // Out of range results abort (__builtin_trap)
+};
+
 struct FixedPrecisionTraits
 {
   bool isSigned = false;
@@ -94,6 +119,8 @@ struct FixedPrecisionTraits
   int power = 0;
   int minBits = bits;
   int maxBits = 63;
+  RoundingPolicy rounding = RoundingPolicy::Truncate;
+  OverflowPolicy overflow = OverflowPolicy::Wrap;
 };
 
 template<IEEE_754::_2008::Binary<32> minValue = 0.0f, IEEE_754::_2008::Binary<32> maxValue = 0.0f>
@@ -116,9 +143,12 @@ struct DynamicRange
   }
 };
 
+// Data of up to 127 bits (128 unsigned) is held in __int128, which GCC and Clang provide on 64-bit targets.
+// The default maxBits keeps results in 64 bits; traits with a maxBits of up to 128 keep their products exact in 128.
+
 template<FixedPrecisionTraits traits>
 concept FixedPrecisionTraitsValidator =
-    traits.minBits >= 0 && traits.minBits <= traits.bits && traits.bits <= traits.maxBits && traits.maxBits <= 64;
+    traits.minBits >= 0 && traits.minBits <= traits.bits && traits.bits <= traits.maxBits && traits.maxBits <= 128;
 
 template <FixedPrecisionTraits traits>
 requires FixedPrecisionTraitsValidator<traits>
@@ -126,6 +156,14 @@ constexpr auto FastestIntegralType()
 {
   // Build time type inference
 
+  if constexpr (traits.isSigned && traits.bits > 63 && traits.bits <= 127) {
+    return static_cast<__int128>(0);
+  }
+
+  if constexpr(!traits.isSigned && traits.bits > 64 && traits.bits <= 128) {
+    return static_cast<unsigned __int128>(0);
+  }
+
   if constexpr (traits.isSigned && traits.bits > 31 && traits.bits <= 63) {
     return std::int_fast64_t(0);
   }
@@ -160,9 +198,9 @@ constexpr auto FastestIntegralType()
 
   // Build time errors
 
-  static_assert(!traits.isSigned || traits.bits <= 63, "\n\n\33[1;31mError: No SIGNED integral types can store more than 63 data traits.bits!\33[0m\n\n");
+  static_assert(!traits.isSigned || traits.bits <= 127, "\n\n\33[1;31mError: No SIGNED integral types can store more than 127 data traits.bits!\33[0m\n\n");
 
-  static_assert(traits.isSigned || traits.bits <= 64, "\n\n\33[1;31mError: No UNSIGNED integral types can store more than 64 data traits.bits!\33[0m\n\n");
+  static_assert(traits.isSigned || traits.bits <= 128, "\n\n\33[1;31mError: No UNSIGNED integral types can store more than 128 data traits.bits!\33[0m\n\n");
 }
 
 template <NumericTraits traits, int bits>
@@ -170,6 +208,14 @@ constexpr auto FastestIntegralType()
 {
   // Build time type inference
 
+  if constexpr ((traits & SIGNED) == SIGNED && bits > 63 && bits <= 127) {
+    return static_cast<__int128>(0);
+  }
+
+  if constexpr((traits & SIGNED) != SIGNED && bits > 64 && bits <= 128) {
+    return static_cast<unsigned __int128>(0);
+  }
+
   if constexpr ((traits & SIGNED) == SIGNED && bits > 31 && bits <= 63) {
     return std::int_fast64_t(0);
   }
@@ -204,9 +250,9 @@ constexpr auto FastestIntegralType()
 
   // Build time errors
 
-  static_assert((traits & SIGNED) != SIGNED || bits <= 63, "\n\n\33[1;31mError: No SIGNED integral types can store more than 63 data bits!\33[0m\n\n");
+  static_assert((traits & SIGNED) != SIGNED || bits <= 127, "\n\n\33[1;31mError: No SIGNED integral types can store more than 127 data bits!\33[0m\n\n");
 
-  static_assert((traits & SIGNED) == SIGNED || bits <= 64, "\n\n\33[1;31mError: No UNSIGNED integral types can store more than 64 data bits!\33[0m\n\n");
+  static_assert((traits & SIGNED) == SIGNED || bits <= 128, "\n\n\33[1;31mError: No UNSIGNED integral types can store more than 128 data bits!\33[0m\n\n");
 }
 
 template <NumericTraits traits, int bits>
@@ -214,6 +260,14 @@ constexpr auto SmallestIntegralType()
 {
   // Build time type inference
 
+  if constexpr ((traits & SIGNED) == SIGNED && bits > 63 && bits <= 127) {
+    return static_cast<__int128>(0);
+  }
+
+  if constexpr((traits & SIGNED) != SIGNED && bits > 64 && bits <= 128) {
+    return static_cast<unsigned __int128>(0);
+  }
+
   if constexpr ((traits & SIGNED) == SIGNED && bits > 31 && bits <= 63) {
     return std::int_least64_t(0);
   }
@@ -248,9 +302,9 @@ constexpr auto SmallestIntegralType()
 
   // Build time errors
 
-  static_assert((traits & SIGNED) != SIGNED || bits <= 63, "\n\n\33[1;31mError: No SIGNED integral types can store more than 63 data bits!\33[0m\n\n");
+  static_assert((traits & SIGNED) != SIGNED || bits <= 127, "\n\n\33[1;31mError: No SIGNED integral types can store more than 127 data bits!\33[0m\n\n");
 
-  static_assert((traits & SIGNED) == SIGNED || bits <= 64, "\n\n\33[1;31mError: No UNSIGNED integral types can store more than 64 data bits!\33[0m\n\n");
+  static_assert((traits & SIGNED) == SIGNED || bits <= 128, "\n\n\33[1;31mError: No UNSIGNED integral types can store more than 128 data bits!\33[0m\n\n");
 }
 
 template<typename IntegralType>
@@ -274,126 +328,344 @@ int CountLeadingZeroes(IntegralType const number)
   static_assert(sizeof(IntegralType) <= sizeof(unsigned long long), "\n\n\33[1;31mError: No clz builtin for supplied arguement!\33[0m\n\n");
 }
 
-template<FixedPrecisionTraits traits>
-requires FixedPrecisionTraitsValidator<traits>
-struct FixedPrecision
+namespace detail {
+
+// 2^power, built from its IEEE 754 fields
+
+template <typename Float, int power>
+constexpr Float PowerOfTwo()
 {
-public:
+  constexpr int Bias = std::numeric_limits<Float>::max_exponent - 1;
 
-  using IntegralType = decltype(FastestIntegralType<traits>());
-  IntegralType data = 0;
+  static_assert(power >= 1 - Bias && power <= Bias, "\n\n\33[1;31mError: 2^power is not a normal floating point number!\33[0m\n\n");
 
-  static constexpr auto Traits = traits;
+  decltype(IEEE_754::_2008::Layout<CHAR_BIT * sizeof(Float)>()) raw{};
+  raw.exponent = Bias + power;
+  return std::bit_cast<Float>(raw);
+}
 
-  FixedPrecision() = default;
-  FixedPrecision(IntegralType const & data) : data(data) {}
+// value * 2^power, with one multiply when 2^power is a normal number, and otherwise several
 
-  using Float32 = IEEE_754::_2008::Binary<32>;
+template <int power, typename Float>
+constexpr Float ScaleByPowerOfTwo(Float const value)
+{
+  constexpr int MaxPower = std::numeric_limits<Float>::max_exponent - 1;
+  constexpr int MinPower = 1 - MaxPower;
 
-  operator Float32() const
-  {
-    // 1. Return zero for the trivial case
+  if constexpr (power >= MinPower && power <= MaxPower) {
+    return value * PowerOfTwo<Float, power>();
+  } else {
+    constexpr int step = power < 0 ? MinPower : MaxPower;
+    return ScaleByPowerOfTwo<power - step>(value * PowerOfTwo<Float, step>());
+  }
+}
 
-    if (data == 0) {
-      return 0.0;
-    }
+constexpr int BitWidth128(unsigned __int128 const value)
+{
+  uint64_t const high = static_cast<uint64_t>(value >> 64);
+  return high != 0 ? 64 + std::bit_width(high) : std::bit_width(static_cast<uint64_t>(value));
+}
 
+// The largest Float not greater than value
 
-    constexpr int MantissaBits = 23;
-    constexpr int ExponentialMax = 127;
-    constexpr int ExponentialBias = 127;
-    constexpr int ExponentialMin = -127;
+template <typename Float>
+constexpr Float FloorToFloat(unsigned __int128 const value)
+{
+  int const excess = BitWidth128(value) - std::numeric_limits<Float>::digits;
+  return excess > 0 ? static_cast<Float>(value >> excess << excess) : static_cast<Float>(value);
+}
 
-    // 2. Check the theoretical data bits,
-    //    Return +inf, -inf, or zero if impossible to represent in the return type
+// Compiles to maxss / minss; NaN gives min
 
-    constexpr auto MSB = traits.bits + traits.power;
-    constexpr auto LSB = 1 + traits.power;
+template <typename Float>
+Float Clamp(Float value, Float const min, Float const max)
+{
+  value = value > min ? value : min;
+  return value < max ? value : max;
+}
 
-    bool const isNegative = traits.isSigned && data < 0;
+template <RoundingPolicy rounding, typename Float>
+Float Round(Float const value)
+{
+  if constexpr (rounding == RoundingPolicy::Truncate) {
+    return std::trunc(value);
+  } else if constexpr (rounding == RoundingPolicy::Convergent) {
+    return std::nearbyint(value);
+  } else {
+    // x - trunc(x) is exact, so ties are detected exactly
+    Float const truncated = std::trunc(value);
+    return truncated + std::copysign(static_cast<Float>(std::fabs(value - truncated) >= Float(0.5)), value);
+  }
+}
 
-    if constexpr(MSB > ExponentialMax) {
-      if (isNegative) {
-        return -std::numeric_limits<Float32>::infinity();
-      } else {
-        return std::numeric_limits<Float32>::infinity();
-      }
-    }
+// Integral policies.  Each is branchless: the rounding increments and the bounds are selected with setcc / cmov,
+// and only Trap has a branch, which is never taken by in range values.
 
-    if constexpr(LSB < ExponentialMin) {
-      return  0.0;
-    }
+// std::make_unsigned, extended to __int128, which the standard traits only know of in GNU modes
+
+template <typename Integral>
+struct Unsigned128 : std::make_unsigned<Integral> {};
+
+template <>
+struct Unsigned128<__int128> { using type = unsigned __int128; };
+
+template <>
+struct Unsigned128<unsigned __int128> { using type = unsigned __int128; };
+
+template <typename Integral>
+using UnsignedOf = typename Unsigned128<Integral>::type;
+
+// std::integral, extended to __int128 likewise
+
+template <typename T>
+concept AnyIntegral = std::integral<T> || std::same_as<T, __int128> || std::same_as<T, unsigned __int128>;
+
+template <typename Integral>
+constexpr bool IsNegative(Integral const value)
+{
+  if constexpr (std::is_same_v<Integral, __int128> || std::is_signed_v<Integral>) {
+    return value < 0;
+  } else {
+    return false;
+  }
+}
+
+// value / 2^shift, rounded according to rounding, from the floor (an arithmetic shift) and the bits shifted out
+
+template <RoundingPolicy rounding, int shift, typename Integral>
+constexpr Integral ShiftRight(Integral const value)
+{
+  if constexpr (shift == 0) {
+    return value;
+  } else if constexpr (shift >= static_cast<int>(CHAR_BIT * sizeof(Integral))) {
+    return 0;
+  } else {
+    using Unsigned = UnsignedOf<Integral>;
 
-    // 3. Check the actual data bits,
-    //    Return +inf, -inf if impossible to represent in the return type
+    constexpr Unsigned Mask = (Unsigned(1) << shift) - 1;
+    constexpr Unsigned Half = Unsigned(1) << (shift - 1);
 
-    typename std::make_unsigned<IntegralType>::type digits;
+    Integral const floor = static_cast<Integral>(value >> shift);
+    Unsigned const remainder = static_cast<Unsigned>(value) & Mask;
 
-    if constexpr(traits.isSigned) {
-      digits = std::abs(data);
+    if constexpr (rounding == RoundingPolicy::Truncate) {
+      return static_cast<Integral>(floor + (IsNegative(value) && remainder != 0));
+    } else if constexpr (rounding == RoundingPolicy::Nearest) {
+      return static_cast<Integral>(floor + (remainder > Half || (remainder == Half && !IsNegative(value))));
     } else {
-      digits = data;
+      return static_cast<Integral>(floor + (remainder > Half || (remainder == Half && (floor & 1) != 0)));
     }
+  }
+}
 
-    std::cout << "Here" << std::endl;
+// The truncated quotient of a division, rounded according to rounding by comparing its remainder with half the divisor
 
-    auto const leadingZeroes = CountLeadingZeroes(digits);
-    auto const actualDataBits = (CHAR_BIT * sizeof(IntegralType)) - leadingZeroes;
-    auto const msb = actualDataBits + traits.power;
+template <RoundingPolicy rounding, AnyIntegral Integral>
+constexpr Integral RoundQuotient(Integral const quotient, Integral const remainder, Integral const divisor)
+{
+  if constexpr (rounding == RoundingPolicy::Truncate) {
+    return quotient;
+  } else {
+    using Unsigned = UnsignedOf<Integral>;
 
-    if (msb > ExponentialMax) {
-      if (isNegative) {
-        return -std::numeric_limits<Float32>::infinity();
-      } else {
-        return std::numeric_limits<Float32>::infinity();
-      }
+    Unsigned const absoluteRemainder = IsNegative(remainder) ? Unsigned(0) - static_cast<Unsigned>(remainder) : static_cast<Unsigned>(remainder);
+    Unsigned const absoluteDivisor = IsNegative(divisor) ? Unsigned(0) - static_cast<Unsigned>(divisor) : static_cast<Unsigned>(divisor);
+
+    // Compared as |r| against |d| - |r|, which cannot overflow
+    bool const above = absoluteRemainder > absoluteDivisor - absoluteRemainder;
+    bool const tie = absoluteRemainder == absoluteDivisor - absoluteRemainder;
+    bool const away = rounding == RoundingPolicy::Nearest ? above || tie : above || (tie && (quotient & 1) != 0);
+
+    // A non-zero remainder has the sign of the dividend
+    Integral const step = IsNegative(remainder) != IsNegative(divisor) ? Integral(-1) : Integral(1);
+
+    return static_cast<Integral>(quotient + (away ? step : Integral(0)));
+  }
+}
+
+// The range of data for the traits' bits
+
+template <FixedPrecisionTraits traits>
+constexpr auto MaxData = traits.bits == 0 ? decltype(FastestIntegralType<traits>())(0)
+                                          : static_cast<decltype(FastestIntegralType<traits>())>(~static_cast<unsigned __int128>(0) >> (128 - traits.bits));
+
+template <FixedPrecisionTraits traits>
+constexpr auto MinData = traits.isSigned ? static_cast<decltype(FastestIntegralType<traits>())>(-MaxData<traits> - 1)
+                                         : decltype(FastestIntegralType<traits>())(0);
+
+// lhs > rhs, of any integrals, as std::cmp_greater, which does not take 128-bit integrals outside GNU modes.
+// Operands of the same sign compare as their two's complement in 128 bits.
+
+template <typename Lhs, typename Rhs>
+constexpr bool IsGreater(Lhs const lhs, Rhs const rhs)
+{
+  if constexpr (sizeof(Lhs) <= sizeof(uint64_t) && sizeof(Rhs) <= sizeof(uint64_t)) {
+    return std::cmp_greater(lhs, rhs);
+  } else {
+    return IsNegative(lhs) != IsNegative(rhs) ? IsNegative(rhs) : static_cast<unsigned __int128>(lhs) > static_cast<unsigned __int128>(rhs);
+  }
+}
+
+template <typename Value, typename Bound>
+constexpr bool Exceeds(Value const value, Bound const bound)
+{
+  return IsGreater(value, bound);
+}
+
+template <typename Value, typename Bound>
+constexpr bool Precedes(Value const value, Bound const bound)
+{
+  return IsGreater(bound, value);
+}
+
+// value, of any integral type, fitted to the range of the traits' bits according to their overflow policy.
+// A value that already wrapped is described by overflowed, as set by __builtin_*_overflow, and the direction
+// of the overflow.
+
+template <FixedPrecisionTraits traits, typename Value>
+constexpr auto Fit(Value const value, bool const overflowed = false, bool const downward = false)
+{
+  using IntegralType = decltype(FastestIntegralType<traits>());
+
+  if constexpr (traits.overflow == OverflowPolicy::Wrap) {
+    return static_cast<IntegralType>(value);
+  } else {
+    bool const above = overflowed ? !downward : Exceeds(value, MaxData<traits>);
+    bool const below = overflowed ? downward : Precedes(value, MinData<traits>);
+
+    if constexpr (traits.overflow == OverflowPolicy::Saturate) {
+      return above ? MaxData<traits> : below ? MinData<traits> : static_cast<IntegralType>(value);
+    } else {
+      if (above || below) __builtin_trap();
+      return static_cast<IntegralType>(value);
     }
-    std::cout << "Here2" << std::endl;
+  }
+}
 
-    // 4. Manually initialize the return type
+// data * 2^(sourceTraits.power - targetTraits.power).  A right shift is rounded according to the target's policy;
+// a left shift is exact, in 64 bits when it fits in 62 and in 128 bits otherwise.  Left shifts beyond 65 bits are
+// bounded to 65: the result is then out of the range of any 64-bit integral, in the same direction, and congruent
+// to the exact result modulo 2^64.  The data is that of the source traits, or an exact intermediate of up to 126 bits
+// in __int128 (see fixed-point-expression.hpp).
 
-    decltype(IEEE_754::_2008::Layout<32>()) raw;
+template <FixedPrecisionTraits targetTraits, FixedPrecisionTraits sourceTraits, typename Data = decltype(FastestIntegralType<sourceTraits>())>
+constexpr auto Align(Data const data)
+{
+  constexpr int shift = sourceTraits.power - targetTraits.power;
 
-    raw.negative = isNegative ? 1 : 0;
-    raw.mantissa = digits << (MantissaBits - actualDataBits + 1);
+  if constexpr (shift <= 0) {
+    return ShiftRight<targetTraits.rounding, -shift>(data);
+  } else {
+    constexpr int bounded = std::min(shift, 65);
 
-    std::cout << "digits " << digits << std::endl;
-    std::cout << "traits.power " << traits.power << std::endl;
-    std::cout << "actualDataBits " << actualDataBits << std::endl;
-    std::cout << "leadingZeroes  " << leadingZeroes << std::endl;
+    static_assert(sourceTraits.bits + bounded <= 126, "\n\n\33[1;31mError: The aligned operand exceeds 128 bits!\33[0m\n\n");
 
-    raw.exponent = ExponentialBias + msb - 1;
+    using Wide = std::conditional_t<sourceTraits.bits + bounded <= 62, int64_t, __int128>;
 
-    std::cout << "raw.negative " << raw.negative << std::endl;
-    std::cout << std::hex;
-    std::cout << "raw.mantissa 0x" << raw.mantissa << std::endl;
-    std::cout << "raw.exponent 0x" << raw.exponent << std::endl;
-    std::cout << std::dec;
+    return static_cast<Wide>(static_cast<Wide>(data) << bounded);
+  }
+}
 
-    Float32 value = std::bit_cast<Float32>(raw);
-    
-  std::cout << "value = " << std::setprecision(15) << value << std::endl;
+// A fused expression of FixedPrecision values (see fixed-point-expression.hpp), evaluated by the FixedPrecision it
+// initializes
 
-   if (traits.power >= 0) {
-     value = (float) data * (1 << traits.power);
-   } else {
-     value = (float) data / (1 << std::abs(traits.power));
-   }
+template <typename Expression>
+concept FusedExpression = Expression::IsFused;
 
-   raw = std::bit_cast<decltype(raw)>(value);
+} // namespace detail
 
-   std::cout << "raw.negative " << raw.negative << std::endl;
-   std::cout << std::hex;
-   std::cout << "raw.mantissa 0x" << raw.mantissa << std::endl;
-   std::cout << "raw.exponent 0x" << raw.exponent << std::endl;
-   std::cout << std::dec;
+template<FixedPrecisionTraits traits>
+requires FixedPrecisionTraitsValidator<traits>
+struct FixedPrecision
+{
+public:
 
-   value = std::bit_cast<Float32>(raw);
-   
+  using IntegralType = decltype(FastestIntegralType<traits>());
+  IntegralType data = 0;
 
-  std::cout << "value = " << std::setprecision(15) << value << std::endl;
- 
-    return value;
+  static constexpr auto Traits = traits;
+
+  constexpr FixedPrecision() = default;
+  constexpr FixedPrecision(IntegralType const & data) : data(data) {}
+
+  // Evaluation of a fused expression, from its exact value, rounded and fitted once to these traits
+  template <detail::FusedExpression Expression>
+  constexpr FixedPrecision(Expression const & expression) : data(expression.template evaluate<traits>()) {}
+
+  // The range of data for the traits' bits
+  static constexpr IntegralType MaxData = detail::MaxData<traits>;
+  static constexpr IntegralType MinData = detail::MinData<traits>;
+
+  using Float32 = IEEE_754::_2008::Binary<32>;
+  using Float64 = IEEE_754::_2008::Binary<64>;
+
+  // Conversion to floating point: the data is converted, rounding to nearest if it has more significant bits than
+  // the mantissa, then scaled by 2^power, a constant built from its exponent.  Out of range values give +/-inf or 0.
+
+  operator Float32() const { return detail::ScaleByPowerOfTwo<traits.power>(static_cast<Float32>(data)); }
+
+  explicit operator Float64() const { return detail::ScaleByPowerOfTwo<traits.power>(static_cast<Float64>(data)); }
+
+  // Conversion from floating point, branchless: the value is scaled by 2^-power, bounded according to overflow,
+  // and rounded according to rounding (Convergent assumes the default floating point rounding mode).
+  // - Saturate clamps to [MinData, MaxData]; NaN gives MinData.
+  // - Wrap keeps the low bits + isSigned bits, as an integral conversion would.
+  // - Trap aborts for values beyond [MinData, MaxData], and NaN.
+  // The policies default to convergent rounding and saturation, rather than to the traits' policies,
+  // as is usual for measured values.
+
+  template <RoundingPolicy rounding = RoundingPolicy::Convergent, OverflowPolicy overflow = OverflowPolicy::Saturate, std::floating_point Float>
+  static FixedPrecision FromFloat(Float value)
+  {
+    // Unsigned 64-bit data exceeds the range of int64_t, and wider data is converted to its own 128-bit integral
+    using Intermediate = std::conditional_t<(sizeof(IntegralType) > sizeof(uint64_t)), IntegralType,
+                                            std::conditional_t<!traits.isSigned && traits.bits == 64, uint64_t, int64_t>>;
+    using Unsigned = detail::UnsignedOf<Intermediate>;
+
+    constexpr int Width = CHAR_BIT * sizeof(Intermediate);
+    constexpr bool SignedIntermediate = detail::IsNegative(static_cast<Intermediate>(-1));
+    constexpr Intermediate Highest = static_cast<Intermediate>(~Unsigned(0) >> SignedIntermediate);
+    constexpr Intermediate Lowest = SignedIntermediate ? static_cast<Intermediate>(-Highest - 1) : Intermediate(0);
+
+    value = detail::ScaleByPowerOfTwo<-traits.power>(value);
+
+    if constexpr (overflow == OverflowPolicy::Trap) {
+      // Rounded values are integral, so none lies between FloorToFloat(MaxData) and MaxData
+      Float const rounded = detail::Round<rounding>(value);
+
+      if (!(rounded >= static_cast<Float>(MinData) && rounded <= detail::FloorToFloat<Float>(MaxData))) __builtin_trap();
+
+      return FixedPrecision(static_cast<IntegralType>(static_cast<Intermediate>(rounded)));
+    }
+
+    if constexpr (overflow == OverflowPolicy::Saturate) {
+      value = detail::Clamp(value, static_cast<Float>(MinData), detail::FloorToFloat<Float>(MaxData));
+    } else {
+      value = detail::Clamp(value, static_cast<Float>(Lowest), detail::FloorToFloat<Float>(Highest));
+    }
+
+    Intermediate integral = static_cast<Intermediate>(detail::Round<rounding>(value));
+
+    if constexpr (overflow == OverflowPolicy::Wrap && traits.bits + traits.isSigned < Width) {
+      constexpr int Unused = Width - (traits.bits + traits.isSigned);
+
+      if constexpr (traits.isSigned) {
+        integral = static_cast<Intermediate>(static_cast<Unsigned>(integral) << Unused) >> Unused;
+      } else {
+        integral = static_cast<Intermediate>(static_cast<Unsigned>(integral) & (~Unsigned(0) >> Unused));
+      }
+    }
+
+    return FixedPrecision(static_cast<IntegralType>(integral));
+  }
+
+  // Conversion from other traits, e.g. of an accumulator to a narrower sample type: the data is aligned to this power,
+  // rounding the bits it drops, and fitted to these bits, according to these traits' policies.
+
+  template <FixedPrecisionTraits sourceTraits>
+  static FixedPrecision FromFixed(FixedPrecision<sourceTraits> const value)
+  {
+    return FixedPrecision(detail::Fit<traits>(detail::Align<traits, sourceTraits>(value.data)));
   }
 
 
@@ -408,23 +680,174 @@ public:
 //template <
 //constexpr FixedPrecisionTraits makeTraits<
 
+namespace detail {
+
+// The most bits a result of maxBits holds: signed results hold at most 127, as their __int128 needs a sign bit
+
+constexpr int HeldBits(bool const isSigned, int const maxBits)
+{
+  return isSigned ? std::min(maxBits, 127) : maxBits;
+}
+
+} // namespace detail
+
+// The traits of a product, shared by the scalar operator and the array kernels (see fixed-point-array.hpp)
+
 template <FixedPrecisionTraits multiplicandTraits, FixedPrecisionTraits multiplierTraits>
-decltype(auto) operator*(FixedPrecision<multiplicandTraits> muliplicand, FixedPrecision<multiplierTraits> multiplier)
+constexpr FixedPrecisionTraits ProductTraits()
 {
+  constexpr bool isSigned = multiplicandTraits.isSigned || multiplierTraits.isSigned;
   constexpr auto maxBits = std::min(multiplicandTraits.maxBits, multiplierTraits.maxBits);
-  constexpr auto minBits = std::min(maxBits, multiplicandTraits.minBits + multiplierTraits.minBits);
+  constexpr auto heldBits = detail::HeldBits(isSigned, maxBits);
+  constexpr auto minBits = std::min(heldBits, multiplicandTraits.minBits + multiplierTraits.minBits);
   //constexpr auto minProductBits = std::max(multiplicandTraits.bits, multiplierTraits.bits);
   constexpr auto maxProductBits = multiplicandTraits.bits + multiplierTraits.bits;
   constexpr auto productPower = multiplicandTraits.power + multiplierTraits.power;
 
-  constexpr FixedPrecisionTraits productTraits = {
-    .isSigned = multiplicandTraits.isSigned || multiplierTraits.isSigned,
-    .bits = maxProductBits < maxBits ? maxProductBits : maxBits,
-    .power = maxProductBits < maxBits ? productPower : productPower + maxProductBits - maxBits,
+  return {
+    .isSigned = isSigned,
+    .bits = maxProductBits < heldBits ? maxProductBits : heldBits,
+    .power = maxProductBits < heldBits ? productPower : productPower + maxProductBits - heldBits,
     .minBits = minBits,
-    .maxBits = maxBits};
+    .maxBits = maxBits,
+    .rounding = std::max(multiplicandTraits.rounding, multiplierTraits.rounding),
+    .overflow = std::max(multiplicandTraits.overflow, multiplierTraits.overflow)};
+}
+
+// Products beyond 128 bits, of operands of up to 128, are computed in 64-bit words: four 64 x 64 -> 128-bit partial
+// products (mulx with BMI2; otherwise the compiler's 128-bit multiply, or 32-bit halves where it has none), summed
+// into a 256-bit magnitude, whose 128 bits above the dropped ones are selected by double shifts (shrd).
+
+namespace detail {
+
+struct Words128
+{
+  uint64_t low;
+  uint64_t high;
+};
+
+constexpr Words128 MultiplyWords(uint64_t const lhs, uint64_t const rhs)
+{
+#if defined(__BMI2__)
+  if (!std::is_constant_evaluated()) {
+    unsigned long long high;
+    uint64_t const low = _mulx_u64(lhs, rhs, &high);
+    return {low, high};
+  }
+#endif
+
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 const product = static_cast<unsigned __int128>(lhs) * rhs;
+  return {static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#else
+  uint64_t const lowLow = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+  uint64_t const highLow = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+  uint64_t const lowHigh = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+  uint64_t const middle = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + (lowHigh & 0xFFFFFFFF);
+  return {(middle << 32) | (lowLow & 0xFFFFFFFF), (lhs >> 32) * (rhs >> 32) + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32)};
+#endif
+}
+
+// |lhs| * |rhs| / 2^shift, rounded according to rounding (on the magnitude, so Truncate is towards zero and Nearest
+// away from zero, as ShiftRight), for a quotient of up to 128 bits
+
+template <RoundingPolicy rounding, int shift>
+constexpr unsigned __int128 MultiplyShiftRight(unsigned __int128 const lhs, unsigned __int128 const rhs)
+{
+  static_assert(shift > 0 && shift < 256, "\n\n\33[1;31mError: The shift exceeds the 256-bit product!\33[0m\n\n");
+
+  uint64_t words[5] = {};
+
+  // words += product * 2^(64 index), with the carries of 64-bit adds
+  auto const accumulate = [&words](int const index, Words128 const product) {
+    words[index] += product.low;
+    uint64_t carry = words[index] < product.low;
+
+    // The high word of a product is at most 2^64 - 2, so the carry cannot overflow it
+    uint64_t const high = product.high + carry;
+    words[index + 1] += high;
+    carry = words[index + 1] < high;
+
+    for (int i = index + 2 ; i < 4 && carry != 0 ; ++i) {
+      carry = ++words[i] == 0;
+    }
+  };
+
+  uint64_t const lhsWords[2] = {static_cast<uint64_t>(lhs), static_cast<uint64_t>(lhs >> 64)};
+  uint64_t const rhsWords[2] = {static_cast<uint64_t>(rhs), static_cast<uint64_t>(rhs >> 64)};
 
-  return FixedPrecision<productTraits>(static_cast<decltype(FastestIntegralType<productTraits>())>(muliplicand.data) * multiplier.data);
+  accumulate(0, MultiplyWords(lhsWords[0], rhsWords[0]));
+  accumulate(1, MultiplyWords(lhsWords[0], rhsWords[1]));
+  accumulate(1, MultiplyWords(lhsWords[1], rhsWords[0]));
+  accumulate(2, MultiplyWords(lhsWords[1], rhsWords[1]));
+
+  // The words from shift, by double shifts of adjacent words
+  constexpr int wordShift = shift / 64;
+  constexpr int bitShift = shift % 64;
+
+  auto const word = [&words](int const index) {
+    uint64_t const low = words[std::min(index, 4)];
+    uint64_t const high = words[std::min(index + 1, 4)];
+    return bitShift == 0 ? low : (low >> bitShift) | (high << ((64 - bitShift) & 63));
+  };
+
+  unsigned __int128 const quotient = static_cast<unsigned __int128>(word(wordShift + 1)) << 64 | word(wordShift);
+
+  if constexpr (rounding == RoundingPolicy::Truncate) {
+    return quotient;
+  } else {
+    // The half bit, and whether any bit below it is set
+    constexpr int halfWord = (shift - 1) / 64;
+    constexpr uint64_t halfMask = uint64_t(1) << ((shift - 1) % 64);
+
+    bool const half = (words[halfWord] & halfMask) != 0;
+    bool sticky = (words[halfWord] & (halfMask - 1)) != 0;
+
+    for (int i = 0 ; i < halfWord ; ++i) sticky |= words[i] != 0;
+
+    bool const away = rounding == RoundingPolicy::Nearest ? half : half && (sticky || (quotient & 1) != 0);
+    return quotient + away;
+  }
+}
+
+} // namespace detail
+
+template <FixedPrecisionTraits multiplicandTraits, FixedPrecisionTraits multiplierTraits>
+decltype(auto) operator*(FixedPrecision<multiplicandTraits> muliplicand, FixedPrecision<multiplierTraits> multiplier)
+{
+  constexpr FixedPrecisionTraits productTraits = ProductTraits<multiplicandTraits, multiplierTraits>();
+  constexpr auto maxProductBits = multiplicandTraits.bits + multiplierTraits.bits;
+
+  using ProductIntegral = decltype(FastestIntegralType<productTraits>());
+
+  if constexpr (maxProductBits <= productTraits.bits) {
+    return FixedPrecision<productTraits>(static_cast<ProductIntegral>(muliplicand.data) * multiplier.data);
+  } else if constexpr (maxProductBits > (productTraits.isSigned ? 127 : 128)) {
+    // The magnitudes' product, in 256 bits, rounded to the product's power, then signed
+    constexpr int excess = maxProductBits - productTraits.bits;
+
+    using Unsigned = detail::UnsignedOf<ProductIntegral>;
+
+    bool const negative = detail::IsNegative(muliplicand.data) != detail::IsNegative(multiplier.data);
+    auto const magnitude = [](auto const value) {
+      return detail::IsNegative(value) ? 0 - static_cast<unsigned __int128>(value) : static_cast<unsigned __int128>(value);
+    };
+
+    Unsigned const product = static_cast<Unsigned>(
+        detail::MultiplyShiftRight<productTraits.rounding, excess>(magnitude(muliplicand.data), magnitude(multiplier.data)));
+
+    return FixedPrecision<productTraits>(static_cast<ProductIntegral>(negative ? 0 - product : product));
+  } else {
+    // The full product, in 128 bits if need be, rounded to the product's power
+    constexpr int excess = maxProductBits - productTraits.bits;
+    constexpr bool isWide = maxProductBits > (productTraits.isSigned ? 63 : 64);
+
+    using Wide = std::conditional_t<isWide, std::conditional_t<productTraits.isSigned, __int128, unsigned __int128>,
+                                            std::conditional_t<productTraits.isSigned, int64_t, uint64_t>>;
+
+    return FixedPrecision<productTraits>(static_cast<ProductIntegral>(
+        detail::ShiftRight<productTraits.rounding, excess>(static_cast<Wide>(static_cast<Wide>(muliplicand.data) * multiplier.data))));
+  }
 }
 
 // NB. The division operators are wrong
@@ -442,10 +865,12 @@ decltype(auto) operator*(FixedPrecision<multiplicandTraits> muliplicand, FixedPr
 //   I need to figure out how to use / calculate the isSigned, bits, minBits, and maxBits traits in this process.
 
 template <FixedPrecisionTraits dividendTraits, FixedPrecisionTraits divisorTraits>
-decltype(auto) operator/(FixedPrecision<dividendTraits> dividend, FixedPrecision<divisorTraits> divisor)
+constexpr FixedPrecisionTraits QuotientTraits()
 {
+  constexpr bool isSigned = dividendTraits.isSigned || divisorTraits.isSigned;
   constexpr auto maxBits = std::min(dividendTraits.maxBits, divisorTraits.maxBits);
-  constexpr auto minBits = std::min(maxBits, dividendTraits.minBits + divisorTraits.minBits);
+  constexpr auto heldBits = detail::HeldBits(isSigned, maxBits);
+  constexpr auto minBits = std::min(heldBits, dividendTraits.minBits + divisorTraits.minBits);
   //constexpr auto minQuotientBits = dividendTraits.bits - divisorTraits.bits;
   //constexpr auto maxQuotientBits = dividendTraits.bits;
   constexpr auto quotientPower = dividendTraits.power - divisorTraits.power;
@@ -453,12 +878,53 @@ decltype(auto) operator/(FixedPrecision<dividendTraits> dividend, FixedPrecision
   // Since integral division is continuous for all divisors != 0,
   // spread the result across as many bits as possible and adjust the power of the quotient accordingly
 
-  constexpr FixedPrecisionTraits quotientTraits = {
-    .isSigned = dividendTraits.isSigned || divisorTraits.isSigned,
-    .bits = maxBits,
-    .power = quotientPower + dividendTraits.bits - maxBits,
+  return {
+    .isSigned = isSigned,
+    .bits = heldBits,
+    .power = quotientPower + dividendTraits.bits - heldBits,
     .minBits = minBits,
-    .maxBits = maxBits};
+    .maxBits = maxBits,
+    .rounding = std::max(dividendTraits.rounding, divisorTraits.rounding),
+    .overflow = std::max(dividendTraits.overflow, divisorTraits.overflow)};
+}
+
+namespace detail {
+
+// dividend / -1, fitted to the traits by their overflow policy.  The quotient of the most negative dividend is the
+// only one to exceed the traits, and may overflow the dividend's integral.
+
+template <FixedPrecisionTraits traits, AnyIntegral Dividend>
+constexpr auto DivideByMinusOne(Dividend const dividend)
+{
+  Dividend quotient;
+  bool const overflowed = __builtin_sub_overflow(Dividend(0), dividend, &quotient);
+
+  return Fit<traits>(quotient, overflowed);
+}
+
+// dividend / divisor, rounded and fitted to the traits of the quotient
+
+template <FixedPrecisionTraits traits, AnyIntegral Dividend, AnyIntegral Divisor>
+constexpr auto DivideRounded(Dividend const dividend, Divisor const divisor)
+{
+  using Common = decltype(dividend / divisor);
+  using IntegralType = decltype(FastestIntegralType<traits>());
+
+  if constexpr (std::same_as<Common, __int128> || std::is_signed_v<Common>) {
+    if (static_cast<Common>(divisor) == -1) return DivideByMinusOne<traits>(static_cast<Common>(dividend));
+  }
+
+  return static_cast<IntegralType>(
+      RoundQuotient<traits.rounding>(static_cast<Common>(dividend / divisor), static_cast<Common>(dividend % divisor), static_cast<Common>(divisor)));
+}
+
+} // namespace detail
+
+template <FixedPrecisionTraits dividendTraits, FixedPrecisionTraits divisorTraits>
+decltype(auto) operator/(FixedPrecision<dividendTraits> dividend, FixedPrecision<divisorTraits> divisor)
+{
+  constexpr FixedPrecisionTraits quotientTraits = QuotientTraits<dividendTraits, divisorTraits>();
+  constexpr auto quotientBits = quotientTraits.bits;
 
   // NB. The order and kind of operations performed during the actual division are critical,
   //     and depend on whether the quotient requires an integral promotion or demotion.
@@ -471,24 +937,375 @@ decltype(auto) operator/(FixedPrecision<dividendTraits> dividend, FixedPrecision
   //     For situations requiring a demotion of the quotient's underlying integral,
   //     right-shifts must be performed prior to static type casts of the dividend and the divisor.
   //
+  //     The quotient is then rounded according to the quotient's rounding policy, from the remainder.
+  //     Only that of the most negative dividend over -1 can exceed the quotient's bits, and is fitted to them
+  //     according to the quotient's overflow policy.
+  //
 
-  if constexpr (dividendTraits.bits <= maxBits) {
-    return FixedPrecision<quotientTraits>(
+  if constexpr (dividendTraits.bits <= quotientBits) {
+    return FixedPrecision<quotientTraits>(detail::DivideRounded<quotientTraits>(
         (                                                                                 // Adjust dividend
            static_cast<decltype(FastestIntegralType<quotientTraits>())>(dividend.data)    //  (1) Promote if needed
-           << (maxBits - dividendTraits.bits)                                             //  (2) Fill underlying integral type
-        )
-        / divisor.data);                                                                  // Perform division
+           << (quotientBits - dividendTraits.bits)                                        //  (2) Fill underlying integral type
+        ),
+        divisor.data));                                                                   // Perform division
   } else {
-    return FixedPrecision<quotientTraits>(
+    return FixedPrecision<quotientTraits>(detail::DivideRounded<quotientTraits>(
         (                                                                                 // Adjust dividend
            static_cast<decltype(FastestIntegralType<quotientTraits>())>                   //  (2) Demote if needed
-           (dividend.data >> (maxBits - dividendTraits.bits))                             //  (1) Discard overflow bits
-        )
-        / static_cast<decltype(FastestIntegralType<quotientTraits>())>(divisor.data));    // Demote divisor if needed then perform division
+           (dividend.data >> (quotientBits - dividendTraits.bits))                        //  (1) Discard overflow bits
+        ),
+        static_cast<decltype(FastestIntegralType<quotientTraits>())>(divisor.data)));     // Demote divisor if needed then perform division
+  }
+}
+
+// Division by constants
+//
+// Granlund & Montgomery, "Division by Invariant Integers using Multiplication": for a divisor d, with
+// l = ceil(log2 d) and m = ceil(2^(64 + l) / d), floor(n / d) = floor(n * m / 2^(64 + l)) for every n < 2^64.
+// m always lies in [2^64, 2^65), so only its low 64 bits are kept, and the quotient is computed as
+// (n + mulhi(n, m - 2^64)) >> l: one multiply, an add and a shift, in 128 bits so that the add cannot carry out.
+// The quotient is exact, i.e. identical to that of the hardware divide, for every dividend.
+
+namespace detail {
+
+template <uint64_t divisor>
+struct UnsignedReciprocal
+{
+  static_assert(divisor != 0, "\n\n\33[1;31mError: Division by zero\33[0m\n\n");
+
+  static constexpr int Shift = std::bit_width(divisor - 1);
+
+  // Divisors above 2^63 give quotients of 0 or 1, for which no multiplier is needed
+  static constexpr uint64_t Multiplier = Shift == 64 ? 0 :
+    static_cast<uint64_t>(((static_cast<unsigned __int128>(1) << (64 + Shift)) + divisor - 1) / divisor);
+
+  static constexpr uint64_t Divide(uint64_t const dividend) {
+    if constexpr (Shift == 64) {
+      return dividend >= divisor;
+    } else {
+      uint64_t const high = static_cast<uint64_t>((static_cast<unsigned __int128>(dividend) * Multiplier) >> 64);
+      return static_cast<uint64_t>((static_cast<unsigned __int128>(dividend) + high) >> Shift);
+    }
+  }
+};
+
+// dividend / divisor, in the usual arithmetic conversions of the two, truncated toward zero.
+// Signed division divides the magnitudes and restores the sign, without branches.
+
+template <auto divisor, std::integral Dividend>
+requires std::integral<decltype(divisor)>
+constexpr auto DivideByConstant(Dividend const dividend)
+{
+  using Common = std::common_type_t<Dividend, decltype(divisor)>;
+
+  static_assert(sizeof(Common) <= sizeof(uint64_t), "\n\n\33[1;31mError: Division by constant is limited to 64-bit integrals\33[0m\n\n");
+
+  constexpr Common commonDivisor = static_cast<Common>(divisor);
+
+  if constexpr (std::is_unsigned_v<Common>) {
+    return static_cast<Common>(UnsignedReciprocal<commonDivisor>::Divide(static_cast<Common>(dividend)));
+  } else {
+    constexpr uint64_t divisorSign = commonDivisor < 0 ? ~uint64_t(0) : 0;
+    constexpr uint64_t divisorMagnitude = (static_cast<uint64_t>(static_cast<int64_t>(commonDivisor)) ^ divisorSign) - divisorSign;
+
+    int64_t const value = static_cast<Common>(dividend);
+    uint64_t const sign = static_cast<uint64_t>(value >> 63);
+    uint64_t const magnitude = UnsignedReciprocal<divisorMagnitude>::Divide((static_cast<uint64_t>(value) ^ sign) - sign);
+    uint64_t const quotientSign = sign ^ divisorSign;
+
+    return static_cast<Common>((magnitude ^ quotientSign) - quotientSign);
+  }
+}
+
+} // namespace detail
+
+// dividend / divisor, for a divisor known at compile time, e.g. DivideBy<Calibration(0x1800)>(sample).
+// Gives the same quotient, traits and all, as operator/, with the hardware divide replaced by a multiply-high and shift.
+
+template <auto divisor, FixedPrecisionTraits dividendTraits>
+requires std::same_as<std::remove_cvref_t<decltype(divisor)>, FixedPrecision<decltype(divisor)::Traits>>
+FixedPrecision<QuotientTraits<dividendTraits, decltype(divisor)::Traits>()> DivideBy(FixedPrecision<dividendTraits> const dividend)
+{
+  constexpr FixedPrecisionTraits divisorTraits = decltype(divisor)::Traits;
+  constexpr FixedPrecisionTraits quotientTraits = QuotientTraits<dividendTraits, divisorTraits>();
+  constexpr auto quotientBits = quotientTraits.bits;
+
+  using QuotientIntegral = decltype(FastestIntegralType<quotientTraits>());
+
+  static_assert(divisor.data != 0, "\n\n\33[1;31mError: Division by zero\33[0m\n\n");
+
+  // The dividend and divisor are adjusted exactly as by operator/, and the remainder of a rounded quotient
+  // is recovered with a multiply
+
+  auto const divide = []<typename Denominator>(auto const numerator, Denominator) {
+    using Common = std::common_type_t<std::remove_const_t<decltype(numerator)>, typename Denominator::value_type>;
+
+    if constexpr (std::is_signed_v<Common> && Denominator::value == -1) {
+      return detail::DivideByMinusOne<quotientTraits>(static_cast<Common>(numerator));
+    } else {
+      using Unsigned = std::make_unsigned_t<Common>;
+
+      Common const quotient = detail::DivideByConstant<Denominator::value>(numerator);
+      Common const denominator = static_cast<Common>(Denominator::value);
+      Common const remainder = static_cast<Common>(static_cast<Unsigned>(numerator) - static_cast<Unsigned>(quotient) * static_cast<Unsigned>(denominator));
+
+      return static_cast<QuotientIntegral>(detail::RoundQuotient<quotientTraits.rounding>(quotient, remainder, denominator));
+    }
+  };
+
+  if constexpr (dividendTraits.bits <= quotientBits) {
+    return FixedPrecision<quotientTraits>(divide(static_cast<QuotientIntegral>(dividend.data) << (quotientBits - dividendTraits.bits),
+                                                 std::integral_constant<decltype(divisor.data), divisor.data>()));
+  } else {
+    return FixedPrecision<quotientTraits>(divide(static_cast<QuotientIntegral>(dividend.data >> (quotientBits - dividendTraits.bits)),
+                                                 std::integral_constant<QuotientIntegral, static_cast<QuotientIntegral>(divisor.data)>()));
+  }
+}
+
+// Addition and subtraction
+//
+// The operands are aligned to the finer of their powers, and the result has one more bit than the wider aligned
+// operand, for the carry (none is needed by the difference of unsigned operands, which is signed).  Only when that
+// exceeds maxBits is the result, like a product, held in maxBits with its least significant bits dropped.
+// So the result's integral is widened only when its bits require it.
+
+template <FixedPrecisionTraits augendTraits, FixedPrecisionTraits addendTraits, bool difference = false>
+constexpr FixedPrecisionTraits SumTraits()
+{
+  constexpr auto maxBits = std::min(augendTraits.maxBits, addendTraits.maxBits);
+  constexpr auto power = std::min(augendTraits.power, addendTraits.power);
+  constexpr auto top = std::max(augendTraits.power + augendTraits.bits, addendTraits.power + addendTraits.bits);
+  constexpr bool isSigned = difference || augendTraits.isSigned || addendTraits.isSigned;
+  constexpr bool carry = !difference || augendTraits.isSigned || addendTraits.isSigned;
+  constexpr auto sumBits = top - power + carry;
+  constexpr auto heldBits = detail::HeldBits(isSigned, maxBits);
+  constexpr auto bits = sumBits < heldBits ? sumBits : heldBits;
+
+  return {
+    .isSigned = isSigned,
+    .bits = bits,
+    .power = sumBits < heldBits ? power : power + sumBits - heldBits,
+    .minBits = std::min(bits, std::max(augendTraits.minBits, addendTraits.minBits)),
+    .maxBits = maxBits,
+    .rounding = std::max(augendTraits.rounding, addendTraits.rounding),
+    .overflow = std::max(augendTraits.overflow, addendTraits.overflow)};
+}
+
+namespace detail {
+
+// high * 2^128 + low, of up to 130 bits, / 2^shift, rounded as ShiftRight, for a result of up to 128 bits
+
+template <RoundingPolicy rounding, int shift>
+constexpr unsigned __int128 ShiftRightWords(int const high, unsigned __int128 const low)
+{
+  static_assert(shift >= 0 && shift <= 130);
+
+  if constexpr (shift == 0) {
+    return low;
+  } else {
+    using Unsigned = unsigned __int128;
+
+    bool const negative = high < 0;
+
+    Unsigned floor;
+    bool above, half, sticky;
+
+    if constexpr (shift < 128) {
+      constexpr Unsigned Half = Unsigned(1) << (shift - 1);
+
+      Unsigned const remainder = low & ((Unsigned(1) << shift) - 1);
+
+      floor = (low >> shift) | (static_cast<Unsigned>(static_cast<__int128>(high)) << (128 - shift));
+      above = remainder > Half;
+      half = remainder == Half;
+      sticky = remainder != 0;
+    } else {
+      constexpr int highShift = shift - 128;
+      constexpr unsigned HighHalf = highShift == 0 ? 0 : 1U << (highShift - 1);
+
+      unsigned const remainder = static_cast<unsigned>(high) & ((1U << highShift) - 1);
+
+      floor = static_cast<Unsigned>(static_cast<__int128>(high >> highShift));
+      above = highShift == 0 ? low > (Unsigned(1) << 127) : remainder > HighHalf || (remainder == HighHalf && low != 0);
+      half = highShift == 0 ? low == (Unsigned(1) << 127) : remainder == HighHalf && low == 0;
+      sticky = remainder != 0 || low != 0;
+    }
+
+    if constexpr (rounding == RoundingPolicy::Truncate) {
+      return floor + (negative && sticky);
+    } else if constexpr (rounding == RoundingPolicy::Nearest) {
+      return floor + (above || (half && !negative));
+    } else {
+      return floor + (above || (half && (floor & 1) != 0));
+    }
+  }
+}
+
+// augend + addend, or augend - addend, exact at the finer of their powers, then rounded to the result's power.
+// The sum is computed in 64 bits or, beyond, in 128 bits; and beyond 126 bits, when each aligned operand fits in 128,
+// in two words: its low 128 bits with their carry, and its high bits (of the signs and the carry).
+
+template <FixedPrecisionTraits resultTraits, bool difference, FixedPrecisionTraits augendTraits, FixedPrecisionTraits addendTraits>
+constexpr auto AddAligned(decltype(FastestIntegralType<augendTraits>()) const augend, decltype(FastestIntegralType<addendTraits>()) const addend)
+{
+  using ResultIntegral = decltype(FastestIntegralType<resultTraits>());
+
+  constexpr int power = std::min(augendTraits.power, addendTraits.power);
+  constexpr int excess = resultTraits.power - power;
+  constexpr int exactBits = resultTraits.bits + excess;
+
+  if constexpr (exactBits <= 126) {
+    using Wide = std::conditional_t<exactBits <= 63, int64_t, __int128>;
+
+    Wide const lhs = static_cast<Wide>(static_cast<Wide>(augend) << (augendTraits.power - power));
+    Wide const rhs = static_cast<Wide>(static_cast<Wide>(addend) << (addendTraits.power - power));
+
+    return static_cast<ResultIntegral>(ShiftRight<resultTraits.rounding, excess>(difference ? lhs - rhs : lhs + rhs));
+  } else {
+    constexpr int augendShift = augendTraits.power - power;
+    constexpr int addendShift = addendTraits.power - power;
+
+    static_assert(augendTraits.bits + augendShift <= (augendTraits.isSigned ? 127 : 128) &&
+                  addendTraits.bits + addendShift <= (addendTraits.isSigned ? 127 : 128),
+                  "\n\n\33[1;31mError: An aligned operand of the sum exceeds 128 bits!\33[0m\n\n");
+
+    using Unsigned = unsigned __int128;
+
+    Unsigned const lhs = static_cast<Unsigned>(augend) << augendShift;
+    Unsigned const rhs = static_cast<Unsigned>(addend) << addendShift;
+
+    int const lhsHigh = -static_cast<int>(IsNegative(augend));
+    int const rhsHigh = -static_cast<int>(IsNegative(addend));
+
+    Unsigned const low = difference ? lhs - rhs : lhs + rhs;
+    int const high = difference ? lhsHigh - rhsHigh - (lhs < rhs) : lhsHigh + rhsHigh + (low < lhs);
+
+    return static_cast<ResultIntegral>(ShiftRightWords<resultTraits.rounding, excess>(high, low));
   }
 }
 
+// value + operand, or value - operand, in the traits of value.  The operand is aligned by Align; the sum is
+// computed with __builtin_*_overflow, whose flag, with the operand's sign, gives the direction of any overflow.
+
+template <FixedPrecisionTraits traits, bool difference, FixedPrecisionTraits operandTraits>
+constexpr auto Accumulate(decltype(FastestIntegralType<traits>()) const value, decltype(FastestIntegralType<operandTraits>()) const operand)
+{
+  using IntegralType = decltype(FastestIntegralType<traits>());
+
+  auto const aligned = Align<traits, operandTraits>(operand);
+
+  if constexpr (std::is_same_v<std::remove_const_t<decltype(aligned)>, __int128> && sizeof(IntegralType) <= sizeof(uint64_t)) {
+    return Fit<traits>(difference ? static_cast<__int128>(value) - aligned : static_cast<__int128>(value) + aligned);
+  } else {
+    IntegralType result;
+
+    bool const overflowed = difference ? __builtin_sub_overflow(value, aligned, &result) : __builtin_add_overflow(value, aligned, &result);
+    bool const downward = difference ? !IsNegative(aligned) : IsNegative(aligned);
+
+    return Fit<traits>(result, overflowed, downward);
+  }
+}
+
+} // namespace detail
+
+template <FixedPrecisionTraits augendTraits, FixedPrecisionTraits addendTraits>
+decltype(auto) operator+(FixedPrecision<augendTraits> augend, FixedPrecision<addendTraits> addend)
+{
+  constexpr FixedPrecisionTraits sumTraits = SumTraits<augendTraits, addendTraits>();
+
+  return FixedPrecision<sumTraits>(detail::AddAligned<sumTraits, false, augendTraits, addendTraits>(augend.data, addend.data));
+}
+
+template <FixedPrecisionTraits minuendTraits, FixedPrecisionTraits subtrahendTraits>
+decltype(auto) operator-(FixedPrecision<minuendTraits> minuend, FixedPrecision<subtrahendTraits> subtrahend)
+{
+  constexpr FixedPrecisionTraits differenceTraits = SumTraits<minuendTraits, subtrahendTraits, true>();
+
+  return FixedPrecision<differenceTraits>(detail::AddAligned<differenceTraits, true, minuendTraits, subtrahendTraits>(minuend.data, subtrahend.data));
+}
+
+// Compound assignment keeps the traits of the left operand, e.g. of an accumulator: the right operand is aligned to
+// its power, rounding the bits finer than it, and the result is fitted to its bits, according to its policies.
+// With the default policies, the sum wraps in its integral, as integral += does.
+
+template <FixedPrecisionTraits traits, FixedPrecisionTraits addendTraits>
+FixedPrecision<traits> & operator+=(FixedPrecision<traits> & augend, FixedPrecision<addendTraits> addend)
+{
+  augend.data = detail::Accumulate<traits, false, addendTraits>(augend.data, addend.data);
+  return augend;
+}
+
+template <FixedPrecisionTraits traits, FixedPrecisionTraits subtrahendTraits>
+FixedPrecision<traits> & operator-=(FixedPrecision<traits> & minuend, FixedPrecision<subtrahendTraits> subtrahend)
+{
+  minuend.data = detail::Accumulate<traits, true, subtrahendTraits>(minuend.data, subtrahend.data);
+  return minuend;
+}
+
+// Comparison of the values represented, exactly, whatever the operands' traits.
+//
+// The coarser operand is shifted up to the finer one's power, in 64 bits when the aligned values fit, and in 128
+// bits otherwise.  A shift of more than the finer operand's bits is capped at one more than them: the finer operand's
+// magnitude is at most 2^bits (of its MinData), so the coarser operand's magnitude still exceeds it whenever it is
+// non-zero.  Beyond 128 bits, a capped shift leaves the coarser operand's sign, or when it is zero the finer one's, to
+// decide; otherwise the coarser operand is compared with the floor of the finer one at its power, and when they are
+// equal, the finer one's bits below that power decide.
+
+namespace detail {
+
+template <FixedPrecisionTraits coarseTraits, FixedPrecisionTraits fineTraits>
+std::strong_ordering CompareAligned(decltype(FastestIntegralType<coarseTraits>()) const coarse,
+                                    decltype(FastestIntegralType<fineTraits>()) const fine)
+{
+  constexpr int shift = std::min(coarseTraits.power - fineTraits.power, fineTraits.bits + 1);
+  constexpr bool isSigned = coarseTraits.isSigned || fineTraits.isSigned;
+  constexpr int bits = std::max(coarseTraits.bits + shift, fineTraits.bits);
+
+  using Wide = std::conditional_t<isSigned, std::conditional_t<bits <= 63, int64_t, __int128>,
+                                            std::conditional_t<bits <= 64, uint64_t, unsigned __int128>>;
+
+  if constexpr (bits > (isSigned ? 127 : 128)) {
+    static_assert(!isSigned || (coarseTraits.bits <= 127 && fineTraits.bits <= 127),
+                  "\n\n\33[1;31mError: A signed comparison of 128-bit unsigned data exceeds 128 bits!\33[0m\n\n");
+
+    if constexpr (shift > fineTraits.bits) {
+      if (coarse != 0) return IsNegative(coarse) ? std::strong_ordering::less : std::strong_ordering::greater;
+      return IsNegative(fine) ? std::strong_ordering::greater : fine != 0 ? std::strong_ordering::less : std::strong_ordering::equal;
+    } else {
+      Wide const lhs = static_cast<Wide>(coarse);
+      Wide const floor = shift < 128 ? static_cast<Wide>(static_cast<Wide>(fine) >> (shift & 127)) : Wide(0);
+      bool const fraction = (shift < 128 ? static_cast<Wide>(fine) - static_cast<Wide>(floor << (shift & 127)) : static_cast<Wide>(fine)) != 0;
+
+      return lhs < floor ? std::strong_ordering::less : lhs > floor ? std::strong_ordering::greater :
+             fraction ? std::strong_ordering::less : std::strong_ordering::equal;
+    }
+  } else {
+    Wide const lhs = static_cast<Wide>(coarse) << shift;
+    Wide const rhs = static_cast<Wide>(fine);
+
+    return lhs < rhs ? std::strong_ordering::less : lhs > rhs ? std::strong_ordering::greater : std::strong_ordering::equal;
+  }
+}
+
+} // namespace detail
+
+template <FixedPrecisionTraits lhsTraits, FixedPrecisionTraits rhsTraits>
+std::strong_ordering operator<=>(FixedPrecision<lhsTraits> lhs, FixedPrecision<rhsTraits> rhs)
+{
+  if constexpr (lhsTraits.power >= rhsTraits.power) {
+    return detail::CompareAligned<lhsTraits, rhsTraits>(lhs.data, rhs.data);
+  } else {
+    return 0 <=> detail::CompareAligned<rhsTraits, lhsTraits>(rhs.data, lhs.data);
+  }
+}
+
+template <FixedPrecisionTraits lhsTraits, FixedPrecisionTraits rhsTraits>
+bool operator==(FixedPrecision<lhsTraits> lhs, FixedPrecision<rhsTraits> rhs)
+{
+  return (lhs <=> rhs) == 0;
+}
+
 //template <FixedPrecisionTraits traits_a, int bits_a, int power_a, FixedPrecisionTraits traits_b, int bits_b, int power_b>
 //decltype(auto) operator*(FixedPrecision<traits_a, bits_a, power_a> && lhs, FixedPrecision<traits_b, bits_b, power_b> && rhs)
 //{
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "endian-hash.hpp"
+
+// FlatHashMap is an open addressing hash map for small, fixed-width keys, e.g. flows indexed by uint32be_t addresses
+// and uint16be_t ports, which are hashed and compared by their encoded bytes (see endian-hash.hpp).
+//
+// Layout
+//   Slots are arranged in groups of 16.  Each slot has a control byte, holding either Empty, Deleted, or the low
+//   7 bits of its key's hash (H2).  Control bytes, keys, and values are held in three separate arrays, so probing
+//   reads only control bytes and, on an H2 match, keys; values are only touched once the key is found.
+//
+// Probing
+//   The remaining hash bits (H1) select the first group; further groups follow a triangular sequence, which visits
+//   every group of a power of two table.  A group's 16 control bytes are matched against H2 with one SSE2 compare,
+//   giving a bit mask of candidate slots.  A lookup ends at the first group with an Empty slot.
+//
+// The load factor is at most 7/8.  Erased slots become Deleted (tombstones) unless their group already has an
+// Empty slot; tombstones are reused by insertion and purged when the table is rehashed.
+//
+// Lookups return a pointer to the value, or nullptr, and pointers are invalidated by any insertion that rehashes.
+
+namespace culyun::hash {
+
+namespace detail {
+
+using Control = int8_t;
+
+constexpr Control Empty = -128;  // 0b10000000
+constexpr Control Deleted = -2;  // 0b11111110
+
+constexpr std::size_t GroupWidth = 16;
+
+// A bit mask over the 16 slots of a group
+
+class Group
+{
+private:
+#if defined(__SSE2__)
+  __m128i control;
+#else
+  Control control[GroupWidth];
+#endif
+
+public:
+  explicit Group(Control const * const position) {
+#if defined(__SSE2__)
+    control = _mm_loadu_si128(reinterpret_cast<__m128i const *>(position));
+#else
+    std::copy(position, position + GroupWidth, control);
+#endif
+  }
+
+  uint32_t match(Control const h2) const {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(h2))));
+#else
+    uint32_t mask = 0;
+    for (std::size_t i = 0 ; i < GroupWidth ; ++i) mask |= uint32_t(control[i] == h2) << i;
+    return mask;
+#endif
+  }
+
+  uint32_t matchEmpty() const { return match(Empty); }
+
+  // Empty and Deleted are the only control bytes with the sign bit set
+  uint32_t matchEmptyOrDeleted() const {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(control));
+#else
+    uint32_t mask = 0;
+    for (std::size_t i = 0 ; i < GroupWidth ; ++i) mask |= uint32_t(control[i] < 0) << i;
+    return mask;
+#endif
+  }
+};
+
+} // namespace detail
+
+template <typename Key, typename Value, typename Hash = BitwiseHash<Key>, typename KeyEqual = BitwiseEqual<Key>>
+requires std::default_initializable<Key> && std::copyable<Key> && std::default_initializable<Value> && std::movable<Value>
+class FlatHashMap
+{
+private:
+  std::vector<detail::Control> controls;
+  std::vector<Key> keys;
+  std::vector<Value> values;
+
+  std::size_t groupMask = 0;   // Group count - 1
+  std::size_t occupied = 0;
+  std::size_t growthLeft = 0;  // Empty slots that may still be filled before the load factor is exceeded
+
+  [[no_unique_address]] Hash hasher;
+  [[no_unique_address]] KeyEqual equal;
+
+  static std::size_t H1(std::size_t const hash) { return hash >> 7; }
+  static detail::Control H2(std::size_t const hash) { return static_cast<detail::Control>(hash & 0x7F); }
+
+  static std::size_t MaxLoad(std::size_t const slots) { return slots - slots / 8; }
+
+  // Calls visit(slot) for each slot of the probe sequence of hash whose control byte is in match(group),
+  // until visit returns true, or a group has an Empty slot.  Returns the slot, or -1.
+
+  template <typename Match, typename Visit>
+  std::ptrdiff_t probe(std::size_t const hash, Match const & match, Visit const & visit) const {
+    if (controls.empty()) return -1;
+
+    std::size_t group = H1(hash) & groupMask;
+
+    for (std::size_t step = 1 ; ; ++step) {
+      std::size_t const first = group * detail::GroupWidth;
+      detail::Group const control(controls.data() + first);
+
+      for (uint32_t mask = match(control) ; mask != 0 ; mask &= mask - 1) {
+        std::size_t const slot = first + std::countr_zero(mask);
+        if (visit(slot)) return static_cast<std::ptrdiff_t>(slot);
+      }
+
+      if (control.matchEmpty() != 0 || step > groupMask) return -1;
+
+      group = (group + step) & groupMask;
+    }
+  }
+
+  std::ptrdiff_t locate(Key const & key, std::size_t const hash) const {
+    detail::Control const h2 = H2(hash);
+
+    return probe(hash,
+                 [h2](detail::Group const & group) { return group.match(h2); },
+                 [this, &key](std::size_t const slot) { return equal(keys[slot], key); });
+  }
+
+  // The first Empty or Deleted slot of hash's probe sequence.  There is always one in a non-empty table,
+  // as the load factor is below 1.
+
+  std::size_t freeSlot(std::size_t const hash) const {
+    std::ptrdiff_t const slot = probe(hash,
+                                      [](detail::Group const & group) { return group.matchEmptyOrDeleted(); },
+                                      [](std::size_t) { return true; });
+    assert(slot >= 0);
+    return static_cast<std::size_t>(slot);
+  }
+
+  void rehash(std::size_t const groups) {
+    assert(std::has_single_bit(groups));
+
+    std::vector<detail::Control> oldControls(groups * detail::GroupWidth, detail::Empty);
+    std::vector<Key> oldKeys(groups * detail::GroupWidth);
+    std::vector<Value> oldValues(groups * detail::GroupWidth);
+
+    oldControls.swap(controls);
+    oldKeys.swap(keys);
+    oldValues.swap(values);
+
+    groupMask = groups - 1;
+    growthLeft = MaxLoad(controls.size()) - occupied;
+
+    // Every key is distinct, so each only needs a free slot
+
+    for (std::size_t slot = 0 ; slot < oldControls.size() ; ++slot) {
+      if (oldControls[slot] < 0) continue;
+
+      std::size_t const hash = hasher(oldKeys[slot]);
+      std::size_t const target = freeSlot(hash);
+
+      controls[target] = H2(hash);
+      keys[target] = std::move(oldKeys[slot]);
+      values[target] = std::move(oldValues[slot]);
+    }
+  }
+
+  static std::size_t GroupsFor(std::size_t const size) {
+    std::size_t groups = 1;
+    while (MaxLoad(groups * detail::GroupWidth) < size) groups *= 2;
+    return groups;
+  }
+
+public:
+  FlatHashMap() = default;
+
+  explicit FlatHashMap(std::size_t const capacity, Hash const & hasher = {}, KeyEqual const & equal = {}) :
+    hasher(hasher), equal(equal)
+  {
+    reserve(capacity);
+  }
+
+  std::size_t size() const { return occupied; }
+  bool empty() const { return occupied == 0; }
+
+  // Slots, of which at most 7/8 are occupied before the table grows
+  std::size_t capacity() const { return controls.size(); }
+
+  void reserve(std::size_t const size) {
+    if (size > occupied + growthLeft) rehash(GroupsFor(size));
+  }
+
+  void clear() {
+    std::fill(controls.begin(), controls.end(), detail::Empty);
+    std::fill(values.begin(), values.end(), Value{});
+    occupied = 0;
+    growthLeft = MaxLoad(controls.size());
+  }
+
+  // Lookup
+
+  Value * find(Key const & key) {
+    std::ptrdiff_t const slot = locate(key, hasher(key));
+    return slot < 0 ? nullptr : &values[slot];
+  }
+
+  Value const * find(Key const & key) const {
+    std::ptrdiff_t const slot = locate(key, hasher(key));
+    return slot < 0 ? nullptr : &values[slot];
+  }
+
+  bool contains(Key const & key) const { return find(key) != nullptr; }
+
+  // Insertion.  Returns the value for key, and whether it was inserted (constructed from args).
+
+  template <typename... Args>
+  std::pair<Value *, bool> try_emplace(Key const & key, Args &&... args) {
+    std::size_t const hash = hasher(key);
+
+    if (std::ptrdiff_t const slot = locate(key, hash) ; slot >= 0) {
+      return { &values[slot], false };
+    }
+
+    if (controls.empty()) rehash(1);
+
+    std::size_t slot = freeSlot(hash);
+
+    // Reusing a tombstone does not change the load, filling an Empty slot does
+    if (controls[slot] == detail::Empty && growthLeft == 0) {
+      std::size_t const groups = groupMask + 1;
+
+      // Double, unless tombstones fill at least half of the allowed load, which rehashing in place recovers
+      rehash(occupied * 2 <= MaxLoad(controls.size()) ? groups : groups * 2);
+      slot = freeSlot(hash);
+    }
+
+    if (controls[slot] == detail::Empty) --growthLeft;
+
+    controls[slot] = H2(hash);
+    keys[slot] = key;
+    values[slot] = Value(std::forward<Args>(args)...);
+    ++occupied;
+
+    return { &values[slot], true };
+  }
+
+  Value & operator[](Key const & key) { return *try_emplace(key).first; }
+
+  // Returns whether key was present
+
+  bool erase(Key const & key) {
+    std::ptrdiff_t const slot = locate(key, hasher(key));
+
+    if (slot < 0) return false;
+
+    // A probe only continues past a group with no Empty slot, so a slot in a group that has one may become Empty
+    std::size_t const first = static_cast<std::size_t>(slot) & ~(detail::GroupWidth - 1);
+    bool const reclaim = detail::Group(controls.data() + first).matchEmpty() != 0;
+
+    controls[slot] = reclaim ? detail::Empty : detail::Deleted;
+    values[slot] = Value{};
+    if (reclaim) ++growthLeft;
+    --occupied;
+
+    return true;
+  }
+
+  // Calls function(key, value) for every entry, in slot order
+
+  template <typename Function>
+  void forEach(Function && function) {
+    for (std::size_t slot = 0 ; slot < controls.size() ; ++slot) {
+      if (controls[slot] >= 0) function(std::as_const(keys[slot]), values[slot]);
+    }
+  }
+
+  template <typename Function>
+  void forEach(Function && function) const {
+    for (std::size_t slot = 0 ; slot < controls.size() ; ++slot) {
+      if (controls[slot] >= 0) function(keys[slot], values[slot]);
+    }
+  }
+};
+
+} // namespace culyun::hash
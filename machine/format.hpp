@@ -0,0 +1,44 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include "endian.hpp"
+#include "fixed-point.hpp"
+
+// fmt::formatter specializations, so wire order and fixed-point values format in place, with the full format spec
+// of their native counterparts, e.g. fmt::format_to(std::back_inserter(buffer), "{:#010x}", header.sequence).
+//
+// - OtherEndian and PackedEndian values format as their native integral.
+// - FixedPrecision values format as the double data * 2^power, which is exact for up to 53 data bits.
+
+template <typename StorageType>
+struct fmt::formatter<culyun::endian::OtherEndian<StorageType>> : fmt::formatter<StorageType>
+{
+  template <typename FormatContext>
+  auto format(culyun::endian::OtherEndian<StorageType> const & value, FormatContext & context) const {
+    return fmt::formatter<StorageType>::format(value.getNativeValue(), context);
+  }
+};
+
+template <typename StorageType, std::endian order, std::size_t width>
+struct fmt::formatter<culyun::endian::PackedEndian<StorageType, order, width>> : fmt::formatter<StorageType>
+{
+  template <typename FormatContext>
+  auto format(culyun::endian::PackedEndian<StorageType, order, width> const & value, FormatContext & context) const {
+    return fmt::formatter<StorageType>::format(value.getNativeValue(), context);
+  }
+};
+
+template <machine::FixedPrecisionTraits traits>
+struct fmt::formatter<machine::FixedPrecision<traits>> : fmt::formatter<double>
+{
+  template <typename FormatContext>
+  auto format(machine::FixedPrecision<traits> const & value, FormatContext & context) const {
+    return fmt::formatter<double>::format(std::ldexp(static_cast<double>(value.data), traits.power), context);
+  }
+};
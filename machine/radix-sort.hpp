@@ -0,0 +1,292 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "endian.hpp"
+#include "endian-float.hpp"
+#include "ieee754_types.hpp"
+
+// Stable LSD radix sort over byte digits, with key transform traits.
+//
+// RadixKey<Key> maps a key onto [Bytes] digits whose unsigned, most-significant-first order is the key's order:
+//
+// - Unsigned integrals are used as is.  Signed integrals, and signed fixed-point values, have their sign bit flipped.
+// - Wire order keys (OtherEndian, PackedEndian) are read byte by byte straight from their encoding; for big-endian
+//   keys the most significant digit is simply the first byte, so no key is ever byte swapped.
+// - IEEE 754 keys (Binary<32/64>, OtherEndianFloat) use the total order transform: negative values are inverted,
+//   positive values have their sign bit set, giving -inf < ... < -0 < +0 < ... < +inf (NaNs sort to the ends).
+//
+// Each pass scatters the records into a scratch buffer by one digit.  A pass is skipped when every record has the
+// same digit, so e.g. small keys in wide types cost only as many passes as they have significant bytes.
+// A single thread builds the histograms of every pass in one read of the keys.  With threads > 1, each pass instead
+// histograms and scatters disjoint chunks in parallel, with per-thread bucket offsets keeping the sort stable.
+//
+// Other key types may be sorted by specializing RadixKey.
+
+namespace culyun::radix {
+
+template <typename Key>
+struct RadixKey;
+
+// Native integrals
+
+template <typename Key>
+requires std::is_integral_v<Key> || endian::Integral128<Key>
+struct RadixKey<Key>
+{
+  static constexpr std::size_t Bytes = sizeof(Key);
+
+  static uint8_t Digit(Key const & key, std::size_t const significance) {
+    using Unsigned = endian::detail::UnsignedOfWidth<sizeof(Key)>;
+
+    Unsigned value = static_cast<Unsigned>(key);
+
+    if constexpr (std::is_signed_v<Key> || std::same_as<std::remove_cv_t<Key>, __int128>) {
+      value ^= Unsigned(1) << (CHAR_BIT * sizeof(Key) - 1);
+    }
+
+    return static_cast<uint8_t>(value >> (CHAR_BIT * significance));
+  }
+};
+
+// Wire order integrals, read from their encoded bytes
+
+namespace detail {
+
+template <typename Key, std::endian order, bool isSigned>
+struct EncodedRadixKey
+{
+  static constexpr std::size_t Bytes = sizeof(Key);
+
+  static uint8_t Digit(Key const & key, std::size_t const significance) {
+    std::size_t const index = order == std::endian::big ? Bytes - 1 - significance : significance;
+
+    uint8_t const digit = reinterpret_cast<uint8_t const *>(&key)[index];
+
+    if constexpr (isSigned) {
+      return significance == Bytes - 1 ? digit ^ 0x80 : digit;
+    } else {
+      return digit;
+    }
+  }
+};
+
+constexpr std::endian OtherEndianOrder = std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+
+} // namespace detail
+
+template <typename StorageType>
+struct RadixKey<endian::OtherEndian<StorageType>> :
+  detail::EncodedRadixKey<endian::OtherEndian<StorageType>, detail::OtherEndianOrder,
+                          std::is_signed_v<StorageType> || std::same_as<StorageType, __int128>>
+{
+};
+
+template <typename StorageType, std::endian order, std::size_t width>
+struct RadixKey<endian::PackedEndian<StorageType, order, width>> :
+  detail::EncodedRadixKey<endian::PackedEndian<StorageType, order, width>, order, std::is_signed_v<StorageType>>
+{
+};
+
+// IEEE 754 binary floating point
+
+namespace detail {
+
+template <typename Encoding>
+constexpr Encoding TotalOrder(Encoding const bits)
+{
+  constexpr Encoding SignMask = Encoding(1) << (CHAR_BIT * sizeof(Encoding) - 1);
+  return (bits & SignMask) ? Encoding(~bits) : Encoding(bits | SignMask);
+}
+
+} // namespace detail
+
+template <typename Key>
+requires std::is_same_v<Key, IEEE_754::_2008::Binary<32>> || std::is_same_v<Key, IEEE_754::_2008::Binary<64>>
+struct RadixKey<Key>
+{
+  static constexpr std::size_t Bytes = sizeof(Key);
+
+  static uint8_t Digit(Key const & key, std::size_t const significance) {
+    using Encoding = endian::detail::UnsignedOfWidth<sizeof(Key)>;
+    return static_cast<uint8_t>(detail::TotalOrder(std::bit_cast<Encoding>(key)) >> (CHAR_BIT * significance));
+  }
+};
+
+template <int width>
+struct RadixKey<endian::OtherEndianFloat<width>>
+{
+  static constexpr std::size_t Bytes = width / CHAR_BIT;
+
+  static uint8_t Digit(endian::OtherEndianFloat<width> const & key, std::size_t const significance) {
+    auto const bits = endian::ReverseBytes(key.getEncodedValue());
+    return static_cast<uint8_t>(detail::TotalOrder(bits) >> (CHAR_BIT * significance));
+  }
+};
+
+// Fixed-point types (e.g. machine::FixedPrecision), recognised by their Traits and underlying data
+
+template <typename Key>
+requires requires { { Key::Traits.isSigned } -> std::convertible_to<bool>; } && std::is_integral_v<decltype(Key::data)>
+struct RadixKey<Key>
+{
+  using IntegralType = std::remove_cvref_t<decltype(std::declval<Key>().data)>;
+
+  static constexpr std::size_t Bytes = sizeof(IntegralType);
+
+  static uint8_t Digit(Key const & key, std::size_t const significance) {
+    return RadixKey<IntegralType>::Digit(key.data, significance);
+  }
+};
+
+template <typename Key>
+concept RadixSortable = requires (Key const & key) {
+  { RadixKey<std::remove_cvref_t<Key>>::Bytes } -> std::convertible_to<std::size_t>;
+  { RadixKey<std::remove_cvref_t<Key>>::Digit(key, std::size_t(0)) } -> std::same_as<uint8_t>;
+};
+
+namespace detail {
+
+using Histogram = std::array<std::size_t, 256>;
+
+// Records per thread below which spawning threads costs more than it saves
+constexpr std::size_t MinRecordsPerThread = 1 << 16;
+
+template <typename Function>
+void ForEachChunk(std::size_t const size, unsigned const threads, Function const & function)
+{
+  if (threads <= 1) {
+    function(0U, std::size_t(0), size);
+    return;
+  }
+
+  std::vector<std::jthread> workers;
+  workers.reserve(threads - 1);
+
+  for (unsigned t = 1 ; t < threads ; ++t) {
+    workers.emplace_back([&function, t, size, threads]() {
+      function(t, size * t / threads, size * (t + 1) / threads);
+    });
+  }
+
+  function(0U, std::size_t(0), size / threads);
+}
+
+} // namespace detail
+
+// Sorts records by the key returned by projection (a member pointer, or any callable), stably.
+// threads == 0 uses one thread per hardware thread.
+
+template <typename Record, typename Projection = std::identity>
+requires std::is_trivially_copyable_v<Record> && std::default_initializable<Record> &&
+         RadixSortable<std::invoke_result_t<Projection &, Record const &>>
+void Sort(std::span<Record> const records, Projection projection = {}, unsigned threads = 1)
+{
+  using Key = std::remove_cvref_t<std::invoke_result_t<Projection &, Record const &>>;
+  using Traits = RadixKey<Key>;
+
+  std::size_t const size = records.size();
+
+  if (size < 2) return;
+
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  threads = static_cast<unsigned>(std::clamp<std::size_t>(size / detail::MinRecordsPerThread, 1, threads));
+
+  std::vector<Record> scratch(size);
+
+  Record * source = records.data();
+  Record * destination = scratch.data();
+
+  std::vector<detail::Histogram> histograms(threads);
+  std::vector<detail::Histogram> offsets(threads);
+
+  // A single thread's digit counts do not depend on the order of the records,
+  // so the histograms of every pass are built up front, in one read of the keys
+
+  std::vector<detail::Histogram> passHistograms(threads == 1 ? Traits::Bytes : 0);
+
+  if (threads == 1) {
+    for (detail::Histogram & histogram : passHistograms) histogram.fill(0);
+
+    for (std::size_t i = 0 ; i < size ; ++i) {
+      Key const & key = std::invoke(projection, source[i]);
+
+      for (std::size_t significance = 0 ; significance < Traits::Bytes ; ++significance) {
+        ++passHistograms[significance][Traits::Digit(key, significance)];
+      }
+    }
+  }
+
+  for (std::size_t significance = 0 ; significance < Traits::Bytes ; ++significance) {
+    auto const digitOf = [&](Record const & record) {
+      return Traits::Digit(std::invoke(projection, record), significance);
+    };
+
+    if (threads == 1) {
+      histograms[0] = passHistograms[significance];
+    } else {
+      detail::ForEachChunk(size, threads, [&](unsigned const t, std::size_t const first, std::size_t const last) {
+        detail::Histogram & histogram = histograms[t];
+        histogram.fill(0);
+
+        for (std::size_t i = first ; i < last ; ++i) {
+          ++histogram[digitOf(source[i])];
+        }
+      });
+    }
+
+    // Skip the pass if every record shares this digit
+
+    std::size_t const firstDigit = digitOf(source[0]);
+    std::size_t sameDigit = 0;
+
+    for (unsigned t = 0 ; t < threads ; ++t) {
+      sameDigit += histograms[t][firstDigit];
+    }
+
+    if (sameDigit == size) continue;
+
+    // Bucket major, thread minor offsets keep records from earlier chunks ahead of later ones
+
+    std::size_t offset = 0;
+
+    for (std::size_t digit = 0 ; digit < 256 ; ++digit) {
+      for (unsigned t = 0 ; t < threads ; ++t) {
+        offsets[t][digit] = offset;
+        offset += histograms[t][digit];
+      }
+    }
+
+    detail::ForEachChunk(size, threads, [&](unsigned const t, std::size_t const first, std::size_t const last) {
+      detail::Histogram & offset = offsets[t];
+
+      for (std::size_t i = first ; i < last ; ++i) {
+        destination[offset[digitOf(source[i])]++] = source[i];
+      }
+    });
+
+    std::swap(source, destination);
+  }
+
+  if (source != records.data()) {
+    std::memcpy(records.data(), source, size * sizeof(Record));
+  }
+}
+
+}
@@ -5,6 +5,15 @@
 #include <type_traits>
 #include <utility>
 #include <string_view>
+#include <vector>
+#include <array>
+#include <span>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <thread>
+#include <cmath>
+#include <iomanip>
 
 #include <fmt/core.h>
 #include <fmt/format.h>
@@ -12,6 +21,18 @@
 #include <boost/ut.hpp>
 
 #include <machine/endian.hpp>
+#include <machine/endian-bulk.hpp>
+#include <machine/wire-struct.hpp>
+#include <machine/endian-float.hpp>
+#include <machine/buffer-reader.hpp>
+#include <machine/atomic-endian.hpp>
+#include <machine/checksum.hpp>
+#include <machine/fixed-point.hpp>
+#include <machine/radix-sort.hpp>
+#include <machine/endian-hash.hpp>
+#include <machine/flat-hash-map.hpp>
+#include <machine/format.hpp>
+#include <bit/field-layout.hpp>
 #include <misc/text.hpp>
 #include <misc/ansi-codes.hpp>
 #include <misc/type-names.hpp>
@@ -193,6 +214,1317 @@ void testStorage()
   );
 }
 
+void testBulkConversion()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0004: endian::ConvertToNative / ConvertToEncoded convert whole spans of endian::OtherEndian integrals\n", reset));
+
+  execute(/* test = */ [](auto const seedValue) {
+      using EndianIntegral = std::remove_const_t<decltype(seedValue)>;
+
+      given("spans of " + type_support::friendly_name<EndianIntegral>() + " values of every length up to several SIMD blocks") = [&]
+      {
+        // Lengths are chosen to exercise each vector kernel and every scalar tail length
+
+        for (std::size_t length = 0 ; length < 160 ; ++length) {
+          std::vector<EndianIntegral> native(length);
+          std::vector<endian::OtherEndian<EndianIntegral>> encoded(length);
+
+          for (std::size_t i = 0 ; i < length ; ++i) {
+            native[i] = static_cast<EndianIntegral>(seedValue * (i + 1));
+          }
+
+          when("calling endian::ConvertToEncoded(native, encoded)") = [&]
+          {
+            endian::ConvertToEncoded<EndianIntegral>(native, encoded);
+
+            then("each encoded element should match its scalar conversion") = [&]
+            {
+              for (std::size_t i = 0 ; i < length ; ++i) {
+                ut::expect(encoded[i].getEncodedValue() == endian::ReverseBytes(native[i]));
+              }
+            };
+          };
+
+          when("calling endian::ConvertToNative(encoded, decoded)") = [&]
+          {
+            std::vector<EndianIntegral> decoded(length);
+            endian::ConvertToNative<EndianIntegral>(encoded, decoded);
+
+            then("the decoded span should equal the original span") = [&]
+            {
+              ut::expect(decoded == native);
+            };
+          };
+
+          when("calling endian::ReverseBytesInPlace(span) twice") = [&]
+          {
+            std::vector<EndianIntegral> buffer = native;
+            endian::ReverseBytesInPlace<EndianIntegral>(buffer);
+
+            bool const reversed = std::equal(buffer.begin(), buffer.end(), native.begin(),
+                                             [](auto const lhs, auto const rhs) { return lhs == endian::ReverseBytes(rhs); });
+
+            endian::ReverseBytesInPlace<EndianIntegral>(buffer);
+
+            then("the first call should reverse each element, and the second should restore the buffer") = [&]
+            {
+              ut::expect(reversed);
+              ut::expect(buffer == native);
+            };
+          };
+        }
+      };
+    },
+    /* seedValues = */ uint16_t(0x1234U), uint32_t(0x12345678UL), uint64_t(0x0123456789ABCDEFULL), int16_t(-3), int32_t(-42), int64_t(-0xBAADF00DLL),
+                       static_cast<unsigned __int128>(0x0123456789ABCDEFULL) << 56, -static_cast<__int128>(0xBAADF00DLL) << 64
+  );
+}
+
+void testUnalignedStorage()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0006: endian::PackedEndian integrals can be overlaid on a wire buffer at any offset\n", reset));
+
+  struct WireHeader
+  {
+    uint16be_u_t type;
+    uint32be_u_t length;
+    uint64le_u_t sequence;
+    int16be_u_t offset;
+  };
+
+  static_assert(alignof(WireHeader) == 1);
+  static_assert(sizeof(WireHeader) == 2 + 4 + 8 + 2);
+  static_assert(std::is_trivially_copyable_v<WireHeader>);
+
+  given("a receive buffer holding a header at an odd offset") = [&]
+  {
+    uint8_t buffer[1 + sizeof(WireHeader)] = {
+      0xEE,                                            // unrelated leading byte
+      0x12, 0x34,                                      // type (be)
+      0x00, 0x01, 0x02, 0x03,                          // length (be)
+      0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,  // sequence (le)
+      0xFF, 0xFE                                       // offset (be)
+    };
+
+    auto * const header = reinterpret_cast<WireHeader *>(buffer + 1);
+
+    when("the fields are read in place") = [&]
+    {
+      then("each field should decode to its native value") = [&]
+      {
+        ut::expect(header->type == 0x1234U);
+        ut::expect(header->length == 0x00010203UL);
+        ut::expect(header->sequence == 0x0102030405060708ULL);
+        ut::expect(header->offset == -2);
+      };
+
+      then("the generic accessors should accept them, as they accept endian::OtherEndian") = [&]
+      {
+        uint24be_t const length24 = 0x010203;
+
+        ut::expect(endian::GetNativeValue(header->offset) == -2);
+        ut::expect(endian::GetBigEndianValue(header->length) == endian::GetBigEndianValue(uint32_t(0x00010203UL)));
+        ut::expect(endian::GetLittleEndianValue(header->sequence) == endian::GetLittleEndianValue(uint64_t(0x0102030405060708ULL)));
+        ut::expect(endian::GetEncodedValue(header->type) == endian::GetEncodedValue(uint16_t(0x1234U)));
+        ut::expect(endian::GetNativeValue(length24) == 0x010203U);
+      };
+    };
+
+    when("the fields are modified in place") = [&]
+    {
+      header->type = 0xABCD;
+      header->length += 0x100;
+      header->sequence |= 0xF0U;
+      --header->offset;
+
+      then("the buffer should hold the updated values in wire order, leaving neighbouring bytes alone") = [&]
+      {
+        ut::expect(buffer[0] == 0xEE);
+        ut::expect(buffer[1] == 0xAB && buffer[2] == 0xCD);
+        ut::expect(buffer[3] == 0x00 && buffer[4] == 0x01 && buffer[5] == 0x03 && buffer[6] == 0x03);
+        ut::expect(buffer[7] == 0xF8 && buffer[14] == 0x01);
+        ut::expect(buffer[15] == 0xFF && buffer[16] == 0xFD);
+      };
+    };
+  };
+
+  execute(/* test = */ [](auto const testValue) {
+      using EndianIntegral = std::remove_const_t<decltype(testValue)>;
+
+      given("a " + type_support::friendly_name<EndianIntegral>() + " value = " + std::to_string(testValue)) = [&]
+      {
+        when("the value is assigned to an equivalent endian::OtherEndianUnaligned integral") = [&]
+        {
+          endian::OtherEndianUnaligned<EndianIntegral> const unaligned = testValue;
+          endian::OtherEndian<EndianIntegral> const aligned = testValue;
+
+          then("the encoding should match endian::OtherEndian") = [&]
+          {
+            ut::expect(unaligned.getEncodedValue() == aligned.getEncodedValue());
+            ut::expect(unaligned == testValue);
+          };
+        };
+      };
+    },
+    /* testValues = */ uint16_t(42), uint32_t(42), uint64_t(0xBAADF00DU), int16_t(-1), int32_t(-42), int64_t(0)
+  );
+}
+
+void testWireStruct()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0007: endian::WireStruct encodes and decodes native structs described by member pointers\n", reset));
+
+  enum class MessageType : uint8_t { Hello = 1, Data = 2 };
+
+  struct Message
+  {
+    MessageType type;
+    int16_t offset;
+    uint32_t length;
+    uint64_t sequence;
+  };
+
+  using BigEndianMessage = endian::WireStruct<std::endian::big, &Message::type, &Message::offset, &Message::length, &Message::sequence>;
+  using NativeMessage = endian::WireStruct<std::endian::native, &Message::type, &Message::offset, &Message::length, &Message::sequence>;
+
+  static_assert(BigEndianMessage::Size == 1 + 2 + 4 + 8);
+  static_assert(BigEndianMessage::Offsets == std::array<std::size_t, 4>{0, 1, 3, 7});
+  static_assert(BigEndianMessage::IndexOf<&Message::length>() == 2);
+  static_assert(!BigEndianMessage::IsNativeLayout); // Message has padding after type
+
+  struct Packet
+  {
+    uint32_t source;
+    uint32_t destination;
+    uint16_t sourcePort;
+    uint16_t destinationPort;
+  };
+
+  using NativePacket = endian::WireStruct<std::endian::native, &Packet::source, &Packet::destination, &Packet::sourcePort, &Packet::destinationPort>;
+  using ShuffledPacket = endian::WireStruct<std::endian::native, &Packet::destination, &Packet::source, &Packet::sourcePort, &Packet::destinationPort>;
+
+  static_assert(NativePacket::IsVerbatim);
+  static_assert(!ShuffledPacket::IsNativeLayout);
+
+  given("a native message") = [&]
+  {
+    Message const message = { .type = MessageType::Data, .offset = -2, .length = 0x01020304UL, .sequence = 0x1122334455667788ULL };
+
+    when("it is encoded big-endian") = [&]
+    {
+      std::array<std::byte, BigEndianMessage::Size> wire = {};
+      BigEndianMessage::Encode(message, wire);
+
+      then("the wire bytes should be packed in big-endian order") = [&]
+      {
+        ut::expect(wire[0] == std::byte{0x02});
+        ut::expect(wire[1] == std::byte{0xFF} && wire[2] == std::byte{0xFE});
+        ut::expect(wire[3] == std::byte{0x01} && wire[6] == std::byte{0x04});
+        ut::expect(wire[7] == std::byte{0x11} && wire[14] == std::byte{0x88});
+      };
+
+      then("decoding, or reading through a view, should restore every field") = [&]
+      {
+        Message const decoded = BigEndianMessage::Decode(wire);
+        ut::expect(decoded.type == message.type);
+        ut::expect(decoded.offset == message.offset);
+        ut::expect(decoded.length == message.length);
+        ut::expect(decoded.sequence == message.sequence);
+
+        auto const view = BigEndianMessage::Overlay(std::span<std::byte const>(wire));
+        ut::expect(view.get<&Message::length>() == message.length);
+        ut::expect(view.get<&Message::offset>() == message.offset);
+      };
+
+      then("fields written through a view should be encoded in place") = [&]
+      {
+        auto const view = BigEndianMessage::Overlay(std::span<std::byte>(wire));
+        view.set<&Message::length>(0xA0B0C0D0UL);
+        ut::expect(wire[3] == std::byte{0xA0} && wire[6] == std::byte{0xD0});
+        ut::expect(view.decode().length == 0xA0B0C0D0UL);
+      };
+    };
+
+    when("it is encoded in native order") = [&]
+    {
+      std::array<std::byte, NativeMessage::Size> wire = {};
+      NativeMessage::Encode(message, wire);
+
+      then("the round trip should restore every field") = [&]
+      {
+        Message const decoded = NativeMessage::Decode(wire);
+        ut::expect(decoded.offset == message.offset);
+        ut::expect(decoded.sequence == message.sequence);
+      };
+    };
+  };
+
+  given("a native packet whose layout matches the wire") = [&]
+  {
+    Packet const packet = { .source = 0x0A000001UL, .destination = 0x0A000002UL, .sourcePort = 80, .destinationPort = 8080 };
+
+    when("it is encoded verbatim, and with a reordered description") = [&]
+    {
+      std::array<std::byte, NativePacket::Size> verbatim = {};
+      std::array<std::byte, ShuffledPacket::Size> shuffled = {};
+      NativePacket::Encode(packet, verbatim);
+      ShuffledPacket::Encode(packet, shuffled);
+
+      then("the verbatim encoding should be the native object representation, and the reordered one should honour the description") = [&]
+      {
+        ut::expect(std::memcmp(verbatim.data(), &packet, sizeof(Packet)) == 0);
+        ut::expect(ShuffledPacket::Decode(shuffled).destination == packet.destination);
+        ut::expect(std::memcmp(shuffled.data(), &packet.destination, sizeof(uint32_t)) == 0);
+      };
+    };
+  };
+}
+
+void testDeferredNative()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0008: endian::DeferredNative applies compound assignment chains natively and re-encodes once\n", reset));
+
+  execute(/* test = */ [](auto const testValue) {
+      using EndianIntegral = std::remove_const_t<decltype(testValue)>;
+
+      given("an endian::OtherEndian<" + type_support::friendly_name<EndianIntegral>() + "> value = " + std::to_string(testValue)) = [&]
+      {
+        endian::OtherEndian<EndianIntegral> other = testValue;
+        EndianIntegral expected = testValue;
+
+        expected *= 3; expected += 7; expected -= 2; expected ^= 0x55; expected <<= 2; expected /= 5;
+
+        when("a chain of compound assignments is applied through endian::Defer") = [&]
+        {
+          {
+            auto native = endian::Defer(other);
+            native *= 3; native += 7; native -= 2; native ^= 0x55; native <<= 2; native /= 5;
+
+            then("the working value should be native, and the encoded value untouched until the scope ends") = [&]
+            {
+              ut::expect(static_cast<EndianIntegral>(native) == expected);
+              ut::expect(other == testValue);
+            };
+          }
+
+          then("the encoded value should hold the result of the whole chain") = [&]
+          {
+            ut::expect(other == expected);
+            ut::expect(other.getEncodedValue() == endian::ReverseBytes(expected));
+          };
+        };
+      };
+    },
+    /* testValues = */ uint16_t(42), uint32_t(0x12345UL), uint64_t(0xBAADF00DU), int16_t(-1), int32_t(-42), int64_t(-0x7FFF0000LL)
+  );
+}
+
+void testWideAndOddWidths()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0009: 24, 48, and 128-bit wire integrals encode and decode in wire order\n", reset));
+
+  static_assert(sizeof(uint24be_t) == 3 && alignof(uint24be_t) == 1);
+  static_assert(sizeof(int48le_t) == 6 && alignof(int48le_t) == 1);
+  static_assert(sizeof(uint128be_t) == 16);
+
+  given("24 and 48-bit values") = [&]
+  {
+    uint24be_t u24be = 0x123456U;
+    int24be_t i24be = -2;
+    uint24le_t u24le = 0x123456U;
+    uint48be_t u48be = 0x123456789ABCULL;
+    int48le_t i48le = -0x123456789ALL;
+
+    auto const * const u24beBytes = reinterpret_cast<uint8_t const *>(&u24be);
+    auto const * const i24beBytes = reinterpret_cast<uint8_t const *>(&i24be);
+    auto const * const u24leBytes = reinterpret_cast<uint8_t const *>(&u24le);
+    auto const * const u48beBytes = reinterpret_cast<uint8_t const *>(&u48be);
+
+    then("the wire bytes should be in the declared order") = [&]
+    {
+      ut::expect(u24beBytes[0] == 0x12 && u24beBytes[1] == 0x34 && u24beBytes[2] == 0x56);
+      ut::expect(i24beBytes[0] == 0xFF && i24beBytes[1] == 0xFF && i24beBytes[2] == 0xFE);
+      ut::expect(u24leBytes[0] == 0x56 && u24leBytes[1] == 0x34 && u24leBytes[2] == 0x12);
+      ut::expect(u48beBytes[0] == 0x12 && u48beBytes[5] == 0xBC);
+    };
+
+    then("the values should decode, sign extending the signed types") = [&]
+    {
+      ut::expect(u24be == 0x123456U);
+      ut::expect(i24be == -2);
+      ut::expect(u24le == 0x123456U);
+      ut::expect(u48be == 0x123456789ABCULL);
+      ut::expect(i48le == -0x123456789ALL);
+    };
+
+    when("values outside the wire range are stored") = [&]
+    {
+      u24be = 0xFF123456UL;
+      i24be = 0x800000;
+
+      then("they should wrap to the wire width") = [&]
+      {
+        ut::expect(u24be == 0x123456U);
+        ut::expect(i24be == -0x800000);
+      };
+    };
+
+    when("arithmetic is performed") = [&]
+    {
+      uint24be_t counter = 0xFFFFFEU;
+      ++counter;
+      int48le_t delta = -1;
+      delta -= 0x7FFFFFFFFFLL;
+
+      then("the results should be held at the wire width") = [&]
+      {
+        ut::expect(counter == 0xFFFFFFU);
+        ++counter;
+        ut::expect(counter == 0U);
+        ut::expect(delta == -0x8000000000LL);
+      };
+    };
+  };
+
+  given("128-bit values") = [&]
+  {
+    unsigned __int128 const value = (static_cast<unsigned __int128>(0x0011223344556677ULL) << 64) | 0x8899AABBCCDDEEFFULL;
+
+    uint128be_t const big = value;
+    int128le_t const little = -static_cast<__int128>(value >> 8);
+
+    auto const * const bigBytes = reinterpret_cast<uint8_t const *>(&big);
+
+    then("they should be encoded in wire order and decode unchanged") = [&]
+    {
+      ut::expect(bigBytes[0] == 0x00 && bigBytes[1] == 0x11 && bigBytes[15] == 0xFF);
+      ut::expect(endian::GetNativeValue(big) == value);
+      ut::expect(endian::GetNativeValue(little) == -static_cast<__int128>(value >> 8));
+    };
+  };
+}
+
+void testFloatingPoint()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0010: endian::OtherEndianFloat values encode IEEE 754 binary32 / binary64 in reverse of native byte ordering\n", reset));
+
+  static_assert(sizeof(float32oe_t) == 4 && sizeof(float64oe_t) == 8);
+
+  given("binary32 and binary64 values") = [&]
+  {
+    float32oe_t const single = 1.5f;
+    float64oe_t const dual = -2.25;
+
+    then("the encodings should be the reversed bit patterns, and decode unchanged") = [&]
+    {
+      ut::expect(single.getEncodedValue() == endian::ReverseBytes(std::bit_cast<uint32_t>(1.5f)));
+      ut::expect(dual.getEncodedValue() == endian::ReverseBytes(std::bit_cast<uint64_t>(-2.25)));
+      ut::expect(single == 1.5f);
+      ut::expect(dual == -2.25);
+    };
+
+    then("arithmetic should be performed natively") = [&]
+    {
+      float32oe_t sum = single;
+      sum += 2.0f;
+      sum *= 2.0f;
+      ut::expect(sum == 7.0f);
+      ut::expect(single * dual == 1.5 * -2.25);
+      ut::expect(-dual == 2.25);
+      ut::expect((-single).getEncodedValue() == endian::ReverseBytes(std::bit_cast<uint32_t>(-1.5f)));
+    };
+  };
+
+  given("spans of binary32 and binary64 values") = [&]
+  {
+    std::vector<float> singles(67);
+    std::vector<double> duals(67);
+
+    for (std::size_t i = 0 ; i < singles.size() ; ++i) {
+      singles[i] = 0.5f * static_cast<float>(i) - 3.0f;
+      duals[i] = -0.25 * static_cast<double>(i) + 1.0e100;
+    }
+
+    when("they are encoded and decoded in bulk") = [&]
+    {
+      std::vector<float32oe_t> encodedSingles(singles.size());
+      std::vector<float64oe_t> encodedDuals(duals.size());
+      std::vector<float> decodedSingles(singles.size());
+      std::vector<double> decodedDuals(duals.size());
+
+      endian::ConvertToEncoded<32>(singles, encodedSingles);
+      endian::ConvertToEncoded<64>(duals, encodedDuals);
+      endian::ConvertToNative<32>(encodedSingles, decodedSingles);
+      endian::ConvertToNative<64>(encodedDuals, decodedDuals);
+
+      then("each element should match its scalar conversion, and the round trip should be exact") = [&]
+      {
+        for (std::size_t i = 0 ; i < singles.size() ; ++i) {
+          ut::expect(encodedSingles[i] == singles[i]);
+          ut::expect(encodedDuals[i] == duals[i]);
+        }
+
+        ut::expect(decodedSingles == singles);
+        ut::expect(decodedDuals == duals);
+      };
+    };
+  };
+}
+
+void testVarint()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0011: varint LEB128 / SLEB128 / ZigZag codecs interleave with endian::OtherEndian fields\n", reset));
+
+  given("a selection of values at the boundaries of each encoded length") = [&]
+  {
+    std::vector<uint64_t> values;
+
+    for (unsigned bits = 0 ; bits <= 64 ; ++bits) {
+      uint64_t const value = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+      values.push_back(value);
+      values.push_back(value + 1);
+    }
+
+    for (uint64_t i = 0 ; i < 300 ; ++i) {
+      values.push_back(i % 7 == 0 ? i * 1000003 : i % 100); // Mostly single byte, with some longer runs
+    }
+
+    std::vector<std::byte> encoded(values.size() * varint::MaxLength<uint64_t>);
+    std::size_t length = 0;
+
+    for (uint64_t const value : values) {
+      length += varint::EncodeLeb128(value, encoded.data() + length);
+    }
+
+    encoded.resize(length);
+
+    when("they are decoded one at a time, and in bulk") = [&]
+    {
+      std::vector<uint64_t> scalar;
+
+      for (std::size_t offset = 0 ; offset < encoded.size() ; ) {
+        uint64_t value = 0;
+        std::size_t const consumed = varint::DecodeLeb128(std::span<std::byte const>(encoded).subspan(offset), value);
+        if (consumed == 0) break;
+        offset += consumed;
+        scalar.push_back(value);
+      }
+
+      std::vector<uint64_t> bulk(values.size());
+      varint::BulkDecodeResult const result = varint::DecodeLeb128(std::span<std::byte const>(encoded), std::span<uint64_t>(bulk));
+
+      then("both should reproduce the original values and consume every byte") = [&]
+      {
+        ut::expect(scalar == values);
+        ut::expect(bulk == values);
+        ut::expect(result.values == values.size());
+        ut::expect(result.bytes == encoded.size());
+      };
+    };
+
+    when("they are bulk decoded into 32-bit values") = [&]
+    {
+      std::vector<uint32_t> narrow(values.size());
+      varint::BulkDecodeResult const result = varint::DecodeLeb128(std::span<std::byte const>(encoded), std::span<uint32_t>(narrow));
+
+      then("decoding should stop at the first value that does not fit") = [&]
+      {
+        ut::expect(result.values == 65U); // (2^n - 1, 2^n) pairs for n = 0 ... 31, then 2^32 - 1, then 2^32
+        ut::expect(narrow[64] == 0xFFFFFFFFUL);
+      };
+    };
+  };
+
+  given("signed values") = [&]
+  {
+    then("ZigZag should map small magnitudes to small codes, and SLEB128 should round trip") = [&]
+    {
+      ut::expect(varint::ZigZagEncode(int32_t(0)) == 0U);
+      ut::expect(varint::ZigZagEncode(int32_t(-1)) == 1U);
+      ut::expect(varint::ZigZagEncode(int32_t(1)) == 2U);
+      ut::expect(varint::ZigZagEncode(std::numeric_limits<int64_t>::min()) == ~uint64_t(0));
+      ut::expect(varint::ZigZagDecode(varint::ZigZagEncode(int64_t(-123456789))) == -123456789);
+
+      for (int64_t const value : {int64_t(0), int64_t(-1), int64_t(63), int64_t(-64), int64_t(64), int64_t(-65),
+                                  std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()}) {
+        std::byte buffer[varint::MaxLength<int64_t>];
+        std::size_t const written = varint::EncodeSleb128(value, buffer);
+        int64_t decoded = 0;
+        ut::expect(varint::DecodeSleb128(std::span<std::byte const>(buffer, written), decoded) == written);
+        ut::expect(decoded == value);
+      }
+    };
+
+    then("SLEB128 encodings whose final group overflows the signed type should be rejected") = [&]
+    {
+      auto const Decode = []<typename Signed>(std::initializer_list<uint8_t> const bytes, Signed & value) {
+        std::vector<std::byte> encoded;
+        for (uint8_t const byte : bytes) encoded.push_back(std::byte(byte));
+        return varint::DecodeSleb128(std::span<std::byte const>(encoded), value);
+      };
+
+      int8_t narrow = 0;
+      int32_t wide = 0;
+
+      ut::expect(Decode({0x80, 0x3F}, narrow) == 0U);
+      ut::expect(Decode({0xFF, 0x40}, narrow) == 0U);
+      ut::expect(Decode({0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, wide) == 0U);
+      ut::expect(Decode({0x80, 0x80, 0x80, 0x80, 0x70}, wide) == 0U);
+
+      ut::expect(Decode({0x80, 0x7F}, narrow) == 2U && narrow == -128);
+      ut::expect(Decode({0xFF, 0x00}, narrow) == 2U && narrow == 127);
+      ut::expect(Decode({0xFF, 0xFF, 0xFF, 0xFF, 0x07}, wide) == 5U && wide == std::numeric_limits<int32_t>::max());
+      ut::expect(Decode({0x80, 0x80, 0x80, 0x80, 0x78}, wide) == 5U && wide == std::numeric_limits<int32_t>::min());
+    };
+  };
+
+  given("a payload mixing fixed big-endian headers and varints") = [&]
+  {
+    std::vector<std::byte> payload(64);
+    std::size_t length = 0;
+
+    uint32be_t const magic = 0xCAFEBABEUL;
+    std::memcpy(payload.data(), &magic, sizeof(magic));
+    length += sizeof(magic);
+    length += varint::EncodeLeb128(uint32_t(300), payload.data() + length);
+    length += varint::EncodeLeb128(varint::ZigZagEncode(int32_t(-3)), payload.data() + length);
+    uint16be_t const trailer = 0xBEEF;
+    std::memcpy(payload.data() + length, &trailer, sizeof(trailer));
+    length += sizeof(trailer);
+    payload.resize(length);
+
+    when("it is read with a varint::BufferReader") = [&]
+    {
+      varint::BufferReader reader(payload);
+
+      uint32be_t readMagic;
+      uint32_t count = 0;
+      int32_t delta = 0;
+      uint16be_t readTrailer;
+      uint16be_t beyondEnd;
+
+      bool const ok = reader.read(readMagic) && reader.readVarint(count) && reader.readZigZag(delta) && reader.read(readTrailer);
+
+      then("every field should decode in one pass, and reading past the end should fail") = [&]
+      {
+        ut::expect(ok);
+        ut::expect(readMagic == 0xCAFEBABEUL);
+        ut::expect(count == 300U);
+        ut::expect(delta == -3);
+        ut::expect(readTrailer == 0xBEEFU);
+        ut::expect(reader.empty());
+        ut::expect(!reader.read(beyondEnd));
+      };
+    };
+  };
+}
+
+void testBitFieldLayout()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0012: bit::BitLayout reads and writes MSB-first bit fields of wire words in place\n", reset));
+
+  // The first word of an IPv4 header: version, IHL, DSCP, ECN, total length
+  using Ipv4Word0 = bit::BitLayout<uint32be_t, 4, 4, 6, 2, 16>;
+
+  struct Ipv4Header
+  {
+    uint32be_t word0;
+    uint32be_t word1;
+  };
+
+  given("an encoded IPv4 header word") = [&]
+  {
+    uint8_t const bytes[] = { 0x45, 0xB9, 0x05, 0xDC };
+    uint32be_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+
+    then("each field should decode from its diagram position") = [&]
+    {
+      ut::expect(Ipv4Word0::UsedBits == 32U);
+      ut::expect(Ipv4Word0::Field<0>::Get(word) == 4U);
+      ut::expect(Ipv4Word0::Field<1>::Get(word) == 5U);
+      ut::expect(Ipv4Word0::Field<2>::Get(word) == 46U); // Expedited forwarding
+      ut::expect(Ipv4Word0::Field<3>::Get(word) == 1U);
+      ut::expect(Ipv4Word0::Field<4>::Get(word) == 1500U);
+    };
+
+    when("a field is set") = [&]
+    {
+      Ipv4Word0::Field<4>::Set(word, 40);
+      Ipv4Word0::Field<3>::Set(word, 0xFF); // Truncated to the field
+
+      then("only that field's bits should change") = [&]
+      {
+        uint8_t encoded[4];
+        std::memcpy(encoded, &word, sizeof(word));
+        ut::expect(encoded[0] == 0x45 && encoded[1] == 0xBB && encoded[2] == 0x00 && encoded[3] == 0x28);
+      };
+    };
+  };
+
+  given("native and 16 / 64-bit words") = [&]
+  {
+    using Flags = bit::BitLayout<uint16_t, 1, 3, 12>;
+    using Wide = bit::BitLayout<uint64be_t, 1, 63>;
+
+    uint16_t flags = 0;
+    Flags::Field<0>::Set(flags, 1);
+    Flags::Field<2>::Set(flags, 0xABC);
+
+    uint64be_t wide = 0;
+    Wide::Field<1>::Set(wide, 0x0123456789ABCDEFULL);
+
+    then("fields should be positioned from the most significant bit") = [&]
+    {
+      ut::expect(flags == 0x8ABC);
+      ut::expect(Flags::Field<1>::Get(flags) == 0U);
+      ut::expect(Wide::Field<0>::Get(wide) == 0U);
+      ut::expect(wide.getNativeValue() == 0x0123456789ABCDEFULL);
+    };
+  };
+
+  given("an array of headers") = [&]
+  {
+    std::vector<Ipv4Header> headers(37);
+
+    for (std::size_t i = 0 ; i < headers.size() ; ++i) {
+      headers[i].word0 = 0x45000000U | static_cast<uint32_t>(20 + i);
+      headers[i].word1 = static_cast<uint32_t>(i);
+    }
+
+    when("a field is extracted from every header, and from a contiguous run of words") = [&]
+    {
+      std::vector<uint16_t> lengths(headers.size());
+      bit::Extract<Ipv4Word0::Field<4>>(std::span<Ipv4Header const>(headers), &Ipv4Header::word0, std::span<uint16_t>(lengths));
+
+      std::vector<uint32be_t> words(headers.size());
+      for (std::size_t i = 0 ; i < headers.size() ; ++i) words[i] = headers[i].word0;
+
+      std::vector<uint8_t> versions(words.size());
+      bit::Extract<Ipv4Word0::Field<0>>(std::span<uint32be_t const>(words), std::span<uint8_t>(versions));
+
+      then("the batch results should match field by field access") = [&]
+      {
+        for (std::size_t i = 0 ; i < headers.size() ; ++i) {
+          ut::expect(lengths[i] == 20 + i);
+          ut::expect(versions[i] == 4U);
+        }
+      };
+    };
+  };
+}
+
+void testFreeBitLists()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0018: bit::FindFreeBits finds the first run of free (zero) bits, MSB-first\n", reset));
+
+  given("free bit lists whose search shifts out every used bit") = [&]
+  {
+    // {freeBitList, bits, index}: once the used bits are shifted out the list is exhausted, i.e. zero
+    constexpr std::array<std::tuple<uint32_t, unsigned, int>, 7> lists = {{
+      {0x00000000U, 1, 0}, {0x00000000U, 32, 0}, {0xFFFF0000U, 16, 16}, {0xFFFF0000U, 17, -1},
+      {0xF0F00000U, 20, 12}, {0xF0F00000U, 21, -1}, {0x80000000U, 31, 1}
+    }};
+
+    then("the unrolled and generic searches should agree on the index of the free run") = [&]
+    {
+      for (auto const & [freeBitList, bits, index] : lists) {
+        ut::expect(bit::FindFreeBits(freeBitList, bits) == index);
+        ut::expect(bit::findFreeBits(freeBitList, bits) == index);
+      }
+    };
+  };
+}
+
+void testAtomicOtherEndian()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0013: endian::AtomicOtherEndian updates atomically, and is always held in wire order\n", reset));
+
+  static_assert(endian::AtomicOtherEndian<uint32_t>::is_always_lock_free);
+  static_assert(sizeof(endian::AtomicOtherEndian<uint64_t>) == sizeof(uint64_t));
+
+  given("a counter shared by several threads") = [&]
+  {
+    constexpr unsigned Threads = 4;
+    constexpr unsigned Increments = 20000;
+
+    atomic_uint32oe_t counter = 0x10000000U;
+
+    when("each thread increments it concurrently") = [&]
+    {
+      std::vector<std::thread> threads;
+
+      for (unsigned t = 0 ; t < Threads ; ++t) {
+        threads.emplace_back([&counter]() {
+          for (unsigned i = 0 ; i < Increments ; ++i) {
+            counter.fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+      }
+
+      for (std::thread & thread : threads) thread.join();
+
+      then("no increments should be lost, and the value should be stored byte swapped") = [&]
+      {
+        uint32_t const expected = 0x10000000U + Threads * Increments;
+        ut::expect(counter.load() == expected);
+
+        uint32_t raw;
+        std::memcpy(&raw, &counter, sizeof(raw));
+        ut::expect(raw == endian::ReverseBytes(expected));
+        ut::expect(counter.loadEncoded().getEncodedValue() == raw);
+      };
+    };
+  };
+
+  given("a signed value") = [&]
+  {
+    atomic_int64oe_t value = -2;
+
+    then("the operations should follow std::atomic semantics") = [&]
+    {
+      ut::expect(value.fetch_add(5) == -2);
+      ut::expect(value.fetch_sub(1) == 3);
+      ut::expect(++value == 3);
+      ut::expect(value-- == 3);
+      ut::expect((value -= 10) == -8);
+
+      int64_t expected = 0;
+      ut::expect(!value.compare_exchange_strong(expected, 42));
+      ut::expect(expected == -8);
+      ut::expect(value.compare_exchange_strong(expected, 42));
+      ut::expect(value.load() == 42);
+
+      ut::expect(value.exchange(std::numeric_limits<int64_t>::max()) == 42);
+      ut::expect(++value == std::numeric_limits<int64_t>::min()); // Wraps
+    };
+  };
+
+  given("a set of flags") = [&]
+  {
+    atomic_uint16oe_t flags = 0x0F01;
+
+    then("the bitwise operations should apply to the native value") = [&]
+    {
+      ut::expect(flags.fetch_or(0x0010) == 0x0F01);
+      ut::expect(flags.fetch_and(0xFF10) == 0x0F11);
+      ut::expect(flags.fetch_xor(0x0110) == 0x0F10);
+      ut::expect(flags.load() == 0x0E00);
+    };
+  };
+}
+
+void testChecksum()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0014: checksum Internet checksum and CRC32C operate directly on encoded buffers\n", reset));
+
+  struct Ipv4Header
+  {
+    uint16be_t versionLengthTos;
+    uint16be_t totalLength;
+    uint16be_t identification;
+    uint16be_t flagsFragment;
+    uint16be_t ttlProtocol;
+    uint16be_t checksum;
+    uint32be_t source;
+    uint32be_t destination;
+  };
+
+  static_assert(sizeof(Ipv4Header) == 20);
+
+  // Reference scalar sum of big-endian 16-bit words
+  auto const referenceSum = [](std::span<std::byte const> const data) {
+    uint64_t sum = 0;
+    for (std::size_t i = 0 ; i < data.size() ; i += 2) {
+      uint16_t const high = std::to_integer<uint8_t>(data[i]);
+      uint16_t const low = i + 1 < data.size() ? std::to_integer<uint8_t>(data[i + 1]) : 0;
+      sum += (high << 8) | low;
+    }
+    while (sum > 0xFFFF) sum = (sum & 0xFFFF) + (sum >> 16);
+    return static_cast<uint16_t>(sum);
+  };
+
+  given("a well known IPv4 header") = [&]
+  {
+    Ipv4Header header;
+    header.versionLengthTos = 0x4500;
+    header.totalLength = 0x0073;
+    header.identification = 0x0000;
+    header.flagsFragment = 0x4000;
+    header.ttlProtocol = 0x4011;
+    header.checksum = 0;
+    header.source = 0xC0A80001U;
+    header.destination = 0xC0A800C7U;
+
+    when("its checksum is calculated") = [&]
+    {
+      header.checksum = checksum::InternetChecksum(std::as_bytes(std::span(&header, 1)));
+
+      then("it should match the published value, and the header should then sum to zero") = [&]
+      {
+        ut::expect(header.checksum == 0xB861);
+        ut::expect(checksum::InternetChecksum(std::as_bytes(std::span(&header, 1))) == 0U);
+      };
+    };
+
+    when("the TTL is decremented, and the source address rewritten, incrementally") = [&]
+    {
+      header.checksum = 0;
+      header.checksum = checksum::InternetChecksum(std::as_bytes(std::span(&header, 1)));
+
+      checksum::SetField(header.checksum, header.ttlProtocol, header.ttlProtocol - 0x0100);
+      checksum::SetField(header.checksum, header.source, 0x0A000001U);
+
+      uint16_t const incremental = header.checksum;
+      header.checksum = 0;
+
+      then("the checksum should match a full recalculation") = [&]
+      {
+        ut::expect(incremental == checksum::InternetChecksum(std::as_bytes(std::span(&header, 1))));
+      };
+    };
+
+    when("a field of an unaligned header is rewritten incrementally") = [&]
+    {
+      struct PackedHeader
+      {
+        uint16be_u_t checksum;
+        uint32be_u_t source;
+      } packed;
+
+      packed.checksum = 0;
+      packed.source = 0xC0A80001U;
+      packed.checksum = checksum::InternetChecksum(std::as_bytes(std::span(&packed, 1)));
+
+      checksum::SetField(packed.checksum, packed.source, 0x0A000001U);
+
+      uint16_t const incremental = packed.checksum;
+      packed.checksum = 0;
+
+      then("the checksum should match a full recalculation") = [&]
+      {
+        ut::expect(incremental == checksum::InternetChecksum(std::as_bytes(std::span(&packed, 1))));
+      };
+    };
+  };
+
+  given("buffers of every length up to a few vector widths, and a large buffer") = [&]
+  {
+    std::vector<std::byte> data(300000);
+    uint32_t state = 12345;
+    for (std::byte & byte : data) {
+      state = state * 1103515245U + 12345U;
+      byte = static_cast<std::byte>(state >> 24);
+    }
+
+    then("the vectorized sum should match the reference sum, including when chained") = [&]
+    {
+      std::span<std::byte const> const bytes(data);
+
+      for (std::size_t size = 0 ; size <= 200 ; ++size) {
+        ut::expect(checksum::Sum(bytes.subspan(1, size)) == referenceSum(bytes.subspan(1, size)));
+      }
+
+      ut::expect(checksum::Sum(bytes) == referenceSum(bytes));
+      ut::expect(checksum::Sum(bytes.subspan(1000), checksum::Sum(bytes.first(1000))) == referenceSum(bytes));
+    };
+  };
+
+  given("CRC32C test vectors") = [&]
+  {
+    std::string_view const digits = "123456789";
+    auto const bytes = std::as_bytes(std::span(digits.data(), digits.size()));
+
+    std::array<std::byte, 32> zeroes = {};
+    std::array<uint32be_t, 8> ones;
+    ones.fill(0xFFFFFFFFU);
+
+    then("the CRCs should match RFC 3720, including when chained") = [&]
+    {
+      ut::expect(checksum::Crc32c(bytes) == 0xE3069283U);
+      ut::expect(checksum::Crc32c(bytes.subspan(4), checksum::Crc32c(bytes.first(4))) == 0xE3069283U);
+      ut::expect(checksum::Crc32c(std::span<std::byte const>(zeroes)) == 0x8A9136AAU);
+      ut::expect(checksum::Crc32c(std::span<uint32be_t const>(ones)) == 0x62A8AB43U);
+    };
+
+    then("long buffers, split into interleaved streams, should match a bitwise reference") = [&]
+    {
+      std::vector<std::byte> data(5000);
+      for (std::size_t i = 0 ; i < data.size() ; ++i) data[i] = static_cast<std::byte>(i * 7 + (i >> 8));
+
+      for (std::size_t const size : {std::size_t(767), std::size_t(768), std::size_t(1543), std::size_t(5000)}) {
+        uint32_t reference = ~uint32_t(0);
+        for (std::size_t i = 0 ; i < size ; ++i) {
+          reference ^= std::to_integer<uint8_t>(data[i]);
+          for (int bit = 0 ; bit < 8 ; ++bit) reference = (reference >> 1) ^ ((reference & 1) ? 0x82F63B78U : 0);
+        }
+
+        ut::expect(checksum::Crc32c(std::span<std::byte const>(data).first(size)) == ~reference);
+      }
+    };
+  };
+}
+
+void testRadixSort()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0015: radix::Sort orders wire-order, signed, fixed-point, and IEEE 754 keys without converting them\n", reset));
+
+  auto random = [state = uint64_t(0x9E3779B97F4A7C15ULL)]() mutable {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+
+  given("big-endian unsigned and signed keys") = [&]
+  {
+    std::vector<uint64be_t> unsignedKeys;
+    std::vector<int32be_t> signedKeys;
+    std::vector<int24be_t> packedKeys;
+
+    for (int i = 0 ; i < 5000 ; ++i) {
+      unsignedKeys.push_back(random());
+      signedKeys.push_back(static_cast<int32_t>(random()));
+      packedKeys.push_back(static_cast<int32_t>(random() % 0x1000000) - 0x800000);
+    }
+
+    radix::Sort(std::span(unsignedKeys));
+    radix::Sort(std::span(signedKeys));
+    radix::Sort(std::span(packedKeys));
+
+    then("they should be in native numeric order") = [&]
+    {
+      auto const nativeOrder = [](auto const & lhs, auto const & rhs) { return lhs.getNativeValue() < rhs.getNativeValue(); };
+      ut::expect(std::is_sorted(unsignedKeys.begin(), unsignedKeys.end(), nativeOrder));
+      ut::expect(std::is_sorted(signedKeys.begin(), signedKeys.end(), nativeOrder));
+      ut::expect(std::is_sorted(packedKeys.begin(), packedKeys.end(), nativeOrder));
+    };
+  };
+
+  given("floating point keys, including signed zeroes and infinities") = [&]
+  {
+    std::vector<double> keys = { 0.0, -0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::denorm_min() };
+    std::vector<float64be_t> wireKeys;
+
+    for (int i = 0 ; i < 2000 ; ++i) {
+      keys.push_back(static_cast<double>(static_cast<int64_t>(random())) / 1e12);
+    }
+
+    for (double const key : keys) wireKeys.push_back(key);
+
+    radix::Sort(std::span(keys));
+    radix::Sort(std::span(wireKeys));
+
+    then("they should be in IEEE 754 total order") = [&]
+    {
+      ut::expect(std::is_sorted(keys.begin(), keys.end()));
+      ut::expect(keys.front() == -std::numeric_limits<double>::infinity());
+
+      auto const zero = std::find(keys.begin(), keys.end(), 0.0);
+      ut::expect(zero + 1 < keys.end() && std::signbit(*zero) && !std::signbit(*(zero + 1)) && *(zero + 1) == 0.0); // -0 < +0
+
+      bool ordered = true;
+      for (std::size_t i = 1 ; i < wireKeys.size() ; ++i) {
+        ordered = ordered && double(wireKeys[i - 1]) <= double(wireKeys[i]);
+      }
+      ut::expect(ordered);
+    };
+  };
+
+  given("signed fixed-point keys") = [&]
+  {
+    using Q7_8 = machine::FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+
+    std::vector<Q7_8> keys;
+    for (int i = 0 ; i < 1000 ; ++i) keys.emplace_back(static_cast<int16_t>(random()));
+
+    radix::Sort(std::span(keys));
+
+    then("they should be in numeric order") = [&]
+    {
+      ut::expect(std::is_sorted(keys.begin(), keys.end(), [](Q7_8 const & lhs, Q7_8 const & rhs) { return lhs.data < rhs.data; }));
+    };
+  };
+
+  given("a large array of records keyed by a big-endian member") = [&]
+  {
+    struct Record
+    {
+      uint64be_t key;
+      uint32_t position;
+    };
+
+    std::vector<Record> records(300000);
+    for (std::size_t i = 0 ; i < records.size() ; ++i) {
+      records[i].key = random() % 1000; // Many duplicates, to check stability
+      records[i].position = static_cast<uint32_t>(i);
+    }
+
+    std::vector<Record> reference = records;
+    std::stable_sort(reference.begin(), reference.end(), [](Record const & lhs, Record const & rhs) { return lhs.key < rhs.key; });
+
+    when("they are sorted by one thread, and by several") = [&]
+    {
+      std::vector<Record> serial = records;
+      std::vector<Record> parallel = records;
+
+      radix::Sort(std::span(serial), &Record::key);
+      radix::Sort(std::span(parallel), &Record::key, 4);
+
+      auto const same = [](std::vector<Record> const & lhs, std::vector<Record> const & rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](Record const & a, Record const & b) {
+          return a.key == b.key && a.position == b.position;
+        });
+      };
+
+      then("both should match a stable comparison sort") = [&]
+      {
+        ut::expect(same(serial, reference));
+        ut::expect(same(parallel, reference));
+      };
+    };
+  };
+}
+
+void testFlatHashMap()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0016: std::hash and FlatHashMap key directly on encoded (wire order) values\n", reset));
+
+  auto random = [state = uint64_t(0x2545F4914F6CDD1DULL)]() mutable {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+
+  given("std::hash of wire order keys") = [&]
+  {
+    uint32be_t const address = 0xC0A80001U;
+    uint32be_t const same = 0xC0A80001U;
+    uint16be_u_t const port = 443;
+
+    then("equal keys should hash equally, and serve as std::unordered_map keys") = [&]
+    {
+      ut::expect(std::hash<uint32be_t>{}(address) == std::hash<uint32be_t>{}(same));
+      ut::expect(std::hash<uint16be_u_t>{}(port) == std::hash<uint16be_u_t>{}(uint16be_u_t(443)));
+
+      std::unordered_map<uint32be_t, int> map;
+      map[address] = 1;
+      ut::expect(map.count(same) == 1U);
+    };
+  };
+
+  given("a FlatHashMap of big-endian addresses, mirrored by a std::unordered_map") = [&]
+  {
+    hash::FlatHashMap<uint32be_t, uint64_t> map;
+    std::unordered_map<uint32_t, uint64_t> reference;
+
+    // Keys from a small range, so that inserts and erases collide with existing entries
+    bool consistent = true;
+
+    for (int i = 0 ; i < 200000 ; ++i) {
+      uint32_t const key = static_cast<uint32_t>(random() % 20000);
+
+      if (random() % 3 == 0) {
+        consistent = consistent && map.erase(key) == (reference.erase(key) == 1U);
+      } else {
+        auto const [value, inserted] = map.try_emplace(key, 0U);
+        consistent = consistent && inserted == (reference.count(key) == 0U);
+        *value += i;
+        reference[key] += i;
+      }
+    }
+
+    then("every entry should match") = [&]
+    {
+      ut::expect(consistent);
+      ut::expect(map.size() == reference.size());
+      ut::expect(map.capacity() * 7 / 8 >= map.size());
+
+      bool matches = true;
+      for (auto const & [key, value] : reference) {
+        uint64_t const * const found = map.find(key);
+        matches = matches && found != nullptr && *found == value;
+      }
+      ut::expect(matches);
+
+      std::size_t visited = 0;
+      map.forEach([&](uint32be_t const & key, uint64_t const & value) {
+        ++visited;
+        matches = matches && reference.at(key) == value;
+      });
+      ut::expect(matches && visited == reference.size());
+      ut::expect(!map.contains(uint32be_t(20000U)));
+    };
+
+    when("it is cleared") = [&]
+    {
+      map.clear();
+
+      then("it should be empty, and reusable") = [&]
+      {
+        ut::expect(map.empty() && !map.contains(uint32be_t(1U)));
+        map[1U] = 7;
+        ut::expect(map.size() == 1U && *map.find(1U) == 7U);
+      };
+    };
+  };
+
+  given("a FlatHashMap keyed by a flow tuple of wire order fields") = [&]
+  {
+    struct Flow
+    {
+      uint32be_t source;
+      uint32be_t destination;
+      uint16be_t sourcePort;
+      uint16be_t destinationPort;
+    };
+
+    static_assert(hash::BitwiseHashable<Flow>);
+
+    hash::FlatHashMap<Flow, int> flows(1000);
+    std::size_t const capacity = flows.capacity();
+
+    for (uint16_t port = 0 ; port < 1000 ; ++port) {
+      flows[Flow{0x0A000001U, 0x0A000002U, port, 80}] = port;
+    }
+
+    then("each flow should be found, without the table growing beyond its reservation") = [&]
+    {
+      bool found = true;
+      for (uint16_t port = 0 ; port < 1000 ; ++port) {
+        int const * const value = flows.find(Flow{0x0A000001U, 0x0A000002U, port, 80});
+        found = found && value != nullptr && *value == port;
+      }
+      ut::expect(found);
+      ut::expect(flows.find(Flow{0x0A000001U, 0x0A000002U, 0, 443}) == nullptr);
+      ut::expect(flows.capacity() == capacity);
+    };
+  };
+}
+
+void testHexFormatting()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-ENDIAN-0017: Hex, hexdump, and fmt formatting of encoded values write into buffers\n", reset));
+
+  given("a buffer of every byte value") = [&]
+  {
+    std::vector<std::byte> bytes(256 + 37);
+    for (std::size_t i = 0 ; i < bytes.size() ; ++i) bytes[i] = static_cast<std::byte>(i);
+
+    when("it is converted to hex") = [&]
+    {
+      std::string hex(2 * bytes.size(), '\0');
+      char * const end = text::toHexInto(hex.data(), std::span<std::byte const>(bytes));
+
+      then("every byte should give its two lower-case digits") = [&]
+      {
+        ut::expect(end == hex.data() + hex.size());
+
+        bool matches = true;
+        for (std::size_t i = 0 ; i < bytes.size() ; ++i) {
+          matches = matches && hex.substr(2 * i, 2) == fmt::format("{:02x}", i & 0xFF);
+        }
+        ut::expect(matches);
+      };
+    };
+  };
+
+  given("integral values") = [&]
+  {
+    then("toHex should zero pad to the width of the type") = [&]
+    {
+      ut::expect(text::toHex(uint8_t(0x0A)) == "0x0a");
+      ut::expect(text::toHex(int16_t(-2)) == "0xfffe");
+      ut::expect(text::toHex(uint32_t(0xC0A80001U)) == "0xc0a80001");
+      ut::expect(text::toHex(uint64_t(1)) == "0x0000000000000001");
+    };
+  };
+
+  given("a packet of 20 bytes") = [&]
+  {
+    std::string_view const request = "GET / HTTP/1.1\r\nHost";
+    auto const bytes = std::as_bytes(std::span(request.data(), request.size()));
+
+    when("it is hexdumped into a fmt::memory_buffer") = [&]
+    {
+      fmt::memory_buffer buffer;
+      text::hexdump(buffer, bytes, 0x100);
+
+      then("it should match hexdump -C") = [&]
+      {
+        ut::expect(fmt::to_string(buffer) ==
+                   "00000100  47 45 54 20 2f 20 48 54  54 50 2f 31 2e 31 0d 0a  |GET / HTTP/1.1..|\n"
+                   "00000110  48 6f 73 74                                       |Host|\n");
+        ut::expect(text::hexdump(bytes.first(16)).size() == text::HexdumpLineLength);
+      };
+    };
+  };
+
+  given("wire order and fixed-point values") = [&]
+  {
+    uint32be_t const address = 0xC0A80001U;
+    int16be_t const delta = -5;
+    uint16be_u_t const port = 443;
+    machine::FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}> const gain(static_cast<int16_t>(-384));
+
+    then("they should format as their native values, with the native format specs") = [&]
+    {
+      ut::expect(fmt::format("{:#010x}", address) == "0xc0a80001");
+      ut::expect(fmt::format("{}", delta) == "-5");
+      ut::expect(fmt::format("{:>5}", port) == "  443");
+      ut::expect(fmt::format("{:.2f}", gain) == "-1.50");
+
+      fmt::memory_buffer buffer;
+      fmt::format_to(std::back_inserter(buffer), "{}:{}", address, port);
+      ut::expect(fmt::to_string(buffer) == "3232235521:443");
+    };
+  };
+}
+
 void testAddition(auto && argSequence)
 {
   ut_helper::log(text::concatenate(
@@ -686,6 +2018,20 @@ int main()
   // Storage, Conversion, and Type Punning
 
   testStorage();
+  testBulkConversion();
+  testUnalignedStorage();
+  testWireStruct();
+  testDeferredNative();
+  testWideAndOddWidths();
+  testFloatingPoint();
+  testVarint();
+  testBitFieldLayout();
+  testFreeBitLists();
+  testAtomicOtherEndian();
+  testChecksum();
+  testRadixSort();
+  testFlatHashMap();
+  testHexFormatting();
 
   // Arithmetic Operations
 
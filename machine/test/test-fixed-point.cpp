@@ -0,0 +1,1361 @@
+#include <string>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <span>
+#include <algorithm>
+#include <cmath>
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include <boost/ut.hpp>
+
+#include <machine/fixed-point.hpp>
+#include <machine/fixed-point-array.hpp>
+#include <machine/fixed-point-math.hpp>
+#include <machine/fixed-point-linear.hpp>
+#include <machine/fixed-point-expression.hpp>
+#include <misc/text.hpp>
+#include <misc/ansi-codes.hpp>
+#include <misc/ut-helpers.hpp>
+
+using namespace ansi_code;
+
+namespace ut = boost::ut;
+using namespace boost::ut::bdd;
+
+namespace {
+
+uint64_t Random()
+{
+  static uint64_t state = 0x9E3779B97F4A7C15ULL;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+// count values whose data is uniformly distributed over the bits of their traits
+
+template <typename Fixed>
+std::vector<Fixed> RandomValues(std::size_t const count, bool const nonZero = false)
+{
+  constexpr auto traits = Fixed::Traits;
+  using IntegralType = typename Fixed::IntegralType;
+
+  std::vector<Fixed> values;
+
+  while (values.size() < count) {
+    uint64_t const magnitude = Random() & ((uint64_t(1) << traits.bits) - 1);
+    bool const negative = traits.isSigned && (Random() & 1) != 0;
+    IntegralType const data = negative ? -static_cast<IntegralType>(magnitude) : static_cast<IntegralType>(magnitude);
+
+    if (nonZero && data == 0) continue;
+
+    values.emplace_back(data);
+  }
+
+  return values;
+}
+
+template <typename Fixed>
+bool SameData(std::vector<Fixed> const & lhs, std::vector<Fixed> const & rhs)
+{
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](Fixed const & a, Fixed const & b) { return a.data == b.data; });
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename Multiplicand, typename Multiplier>
+void checkProducts(std::string_view const name)
+{
+  using Product = machine::ProductOf<Multiplicand, Multiplier>;
+
+  // Not a multiple of any vector width, so the scalar remainder is exercised too
+  constexpr std::size_t Count = 1003;
+
+  auto const multiplicands = RandomValues<Multiplicand>(Count);
+  auto const multipliers = RandomValues<Multiplier>(Count);
+  Multiplier const factor = RandomValues<Multiplier>(1, true).front();
+
+  std::vector<Product> expectedProducts, expectedScaled, expectedSums;
+
+  for (std::size_t i = 0 ; i < Count ; ++i) {
+    expectedProducts.push_back(multiplicands[i] * multipliers[i]);
+    expectedScaled.push_back(multiplicands[i] * factor);
+    expectedSums.push_back((multiplicands[i] * multipliers[i]).data + expectedProducts[i].data);
+  }
+
+  given(std::string(name)) = [&]
+  {
+    std::vector<Product> products(Count), scaled(Count);
+
+    machine::Multiply(multiplicands, multipliers, products);
+    machine::Scale(std::span(multiplicands), factor, std::span(scaled));
+
+    std::vector<Product> sums = products;
+    machine::MultiplyAccumulate(multiplicands, multipliers, sums);
+
+    then("the array kernels should match the scalar operators") = [&]
+    {
+      ut::expect(SameData(products, expectedProducts));
+      ut::expect(SameData(scaled, expectedScaled));
+      ut::expect(SameData(sums, expectedSums));
+    };
+
+    then("the array kernels should leave empty ranges untouched") = [&]
+    {
+      std::vector<Multiplicand> const noMultiplicands;
+      std::vector<Multiplier> const noMultipliers;
+      std::vector<Product> noProducts, noSums;
+
+      machine::Multiply(noMultiplicands, noMultipliers, noProducts);
+      machine::Scale(std::span(noMultiplicands), factor, std::span(noProducts));
+      machine::MultiplyAccumulate(noMultiplicands, noMultipliers, noSums);
+
+      ut::expect(noProducts.empty() && noSums.empty());
+    };
+  };
+}
+
+template <typename Dividend, typename Divisor>
+void checkQuotients(std::string_view const name)
+{
+  using Quotient = machine::QuotientOf<Dividend, Divisor>;
+
+  constexpr std::size_t Count = 1003;
+
+  auto const dividends = RandomValues<Dividend>(Count);
+  auto const divisors = RandomValues<Divisor>(Count, true);
+
+  std::vector<Quotient> expected;
+
+  for (std::size_t i = 0 ; i < Count ; ++i) {
+    expected.push_back(dividends[i] / divisors[i]);
+  }
+
+  given(std::string(name)) = [&]
+  {
+    std::vector<Quotient> quotients(Count);
+
+    machine::Divide(dividends, divisors, quotients);
+
+    then("the array kernel should match the scalar operator") = [&]
+    {
+      ut::expect(SameData(quotients, expected));
+    };
+  };
+}
+
+template <auto divisor, typename Dividend>
+void checkConstantQuotients(std::string_view const name)
+{
+  constexpr std::size_t Count = 1003;
+
+  auto dividends = RandomValues<Dividend>(Count);
+  dividends.emplace_back(Dividend::MaxData);
+  dividends.emplace_back(Dividend::MinData);
+
+  given(std::string(name)) = [&]
+  {
+    then("the quotients should match those of the hardware divide") = [&]
+    {
+      std::size_t mismatches = 0;
+
+      for (Dividend const & dividend : dividends) {
+        auto const quotient = machine::DivideBy<divisor>(dividend);
+
+        static_assert(std::is_same_v<decltype(quotient), decltype(dividend / divisor) const>);
+
+        mismatches += quotient.data != (dividend / divisor).data;
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+}
+
+template <auto... divisors>
+bool ReciprocalsAreExact(std::span<uint64_t const> const dividends)
+{
+  auto const exact = [&]<auto divisor>() {
+    return std::all_of(dividends.begin(), dividends.end(), [](uint64_t const dividend) {
+      using Integral = decltype(divisor);
+      Integral const value = static_cast<Integral>(dividend);
+
+      // The one quotient that overflows
+      if (std::is_signed_v<Integral> && std::cmp_equal(divisor, -1) && value == std::numeric_limits<Integral>::min()) return true;
+
+      return machine::detail::DivideByConstant<divisor>(value) == value / divisor;
+    });
+  };
+
+  return (exact.template operator()<divisors>() && ...);
+}
+
+template <typename Multiplicand, typename Multiplier>
+void checkSaturatingAccumulation(std::string_view const name)
+{
+  using Product = machine::ProductOf<Multiplicand, Multiplier>;
+
+  constexpr std::size_t Count = 1003;
+
+  auto const multiplicands = RandomValues<Multiplicand>(Count);
+  auto const multipliers = RandomValues<Multiplier>(Count);
+
+  // Sums near either bound, so that many accumulations saturate
+  std::vector<Product> sums;
+
+  for (std::size_t i = 0 ; i < Count ; ++i) {
+    sums.emplace_back(i % 2 == 0 ? Product::MaxData - static_cast<typename Product::IntegralType>(i) : Product::MinData + static_cast<typename Product::IntegralType>(i));
+  }
+
+  std::vector<Product> expected = sums;
+
+  for (std::size_t i = 0 ; i < Count ; ++i) {
+    expected[i] += multiplicands[i] * multipliers[i];
+  }
+
+  given(std::string(name)) = [&]
+  {
+    machine::MultiplyAccumulate(multiplicands, multipliers, sums);
+
+    then("the array kernel should saturate as operator+= does") = [&]
+    {
+      ut::expect(SameData(sums, expected));
+      ut::expect(std::all_of(sums.begin(), sums.end(), [](Product const & sum) { return sum.data >= Product::MinData && sum.data <= Product::MaxData; }));
+    };
+  };
+}
+
+// The largest error of function(values[i]) from reference(values[i]), in units of the result's last place
+
+template <typename Fixed, typename Function, typename Reference>
+long double WorstError(std::vector<Fixed> const & values, Function const & function, Reference const & reference)
+{
+  long double worst = 0;
+
+  for (Fixed const value : values) {
+    auto const result = function(value);
+    constexpr int power = decltype(result)::Traits.power;
+
+    long double const exact = reference(std::ldexp(static_cast<long double>(value.data), Fixed::Traits.power));
+    worst = std::max(worst, std::fabs(std::ldexp(static_cast<long double>(result.data), power) - exact) * std::ldexp(1.0L, -power));
+  }
+
+  return worst;
+}
+
+// The exact sum of coefficients[k] * operands[k * stride], for k < count
+
+template <typename Coefficient, typename Operand>
+__int128 ExactSum(Coefficient const * const coefficients, std::size_t const count, Operand const * const operands, std::ptrdiff_t const stride)
+{
+  __int128 sum = 0;
+
+  for (std::size_t k = 0 ; k < count ; ++k) {
+    sum += static_cast<__int128>(coefficients[k].data) * static_cast<__int128>(operands[static_cast<std::ptrdiff_t>(k) * stride].data);
+  }
+
+  return sum;
+}
+
+void testFixedPrecisionArrays()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0001: FixedPrecision array kernels derive the traits, and the values, of the scalar operators\n", reset));
+
+  using machine::FixedPrecision;
+
+  using Q3_4 = FixedPrecision<{.isSigned = true, .bits = 7, .power = -4}>;
+  using UQ0_8 = FixedPrecision<{.isSigned = false, .bits = 8, .power = -8}>;
+  using Q7_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using UQ16_16 = FixedPrecision<{.isSigned = false, .bits = 32, .power = -16}>;
+  using Q23_16 = FixedPrecision<{.isSigned = true, .bits = 39, .power = -16}>;
+  using Q3_20 = FixedPrecision<{.isSigned = true, .bits = 23, .power = -20}>;
+
+  checkProducts<Q7_8, Q7_8>("Q7.8 x Q7.8, a signed 32 x 32-bit product");
+  checkProducts<UQ16_16, UQ16_16>("UQ16.16 x UQ16.16, an unsigned 32 x 32-bit product");
+  checkProducts<Q23_16, Q3_20>("Q23.16 x Q3.20, a 64-bit product");
+  checkProducts<Q3_4, UQ0_8>("Q3.4 x UQ0.8, widened from 8-bit operands");
+  checkProducts<Q7_8, UQ16_16>("Q7.8 x UQ16.16, of mixed signedness");
+
+  using Q7_8_48 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .maxBits = 48}>;
+  using Q3_12_48 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -12, .maxBits = 48}>;
+
+  checkQuotients<Q7_8_48, Q3_12_48>("Q7.8 / Q3.12 with 48-bit quotients, exact in double precision");
+  checkQuotients<Q7_8, Q7_8>("Q7.8 / Q7.8 with 63-bit quotients, divided by the scalar operator");
+}
+
+template <typename Fixed, machine::RoundingPolicy rounding>
+void checkBulkConversion(std::string_view const name)
+{
+  constexpr std::size_t Count = 1003;
+
+  // Values spanning the range of Fixed, and beyond it, with ties, infinities and NaN
+  double const range = std::ldexp(1.0, Fixed::Traits.bits + Fixed::Traits.power);
+
+  std::vector<float> floats;
+  for (std::size_t i = 0 ; i < Count ; ++i) {
+    double const unit = static_cast<double>(static_cast<int64_t>(Random() % 2000001) - 1000000) / 1000000.0;
+    floats.push_back(static_cast<float>(unit * range * 1.25));
+  }
+
+  floats[0] = std::numeric_limits<float>::infinity();
+  floats[1] = -std::numeric_limits<float>::infinity();
+  floats[2] = std::numeric_limits<float>::quiet_NaN();
+  floats[3] = std::ldexp(2.5f, Fixed::Traits.power);
+  floats[4] = std::ldexp(-2.5f, Fixed::Traits.power);
+  floats[5] = std::ldexp(3.5f, Fixed::Traits.power);
+
+  given(std::string(name)) = [&]
+  {
+    std::vector<Fixed> fixeds(Count);
+    std::vector<float> roundTrip(Count);
+
+    machine::FromFloat<rounding>(floats, fixeds);
+    machine::ToFloat(fixeds, roundTrip);
+
+    then("the array conversions should match the scalar conversions") = [&]
+    {
+      bool matches = true;
+
+      for (std::size_t i = 0 ; i < Count ; ++i) {
+        Fixed const expected = Fixed::template FromFloat<rounding>(floats[i]);
+        matches = matches && fixeds[i].data == expected.data && roundTrip[i] == static_cast<float>(expected);
+      }
+
+      ut::expect(matches);
+    };
+  };
+}
+
+void testFloatConversion()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0002: FixedPrecision converts to and from floating point, with rounding and overflow policies\n", reset));
+
+  using machine::FixedPrecision;
+  using machine::RoundingPolicy;
+  using machine::OverflowPolicy;
+
+  using Q7_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using UQ8_8 = FixedPrecision<{.isSigned = false, .bits = 16, .power = -8}>;
+  using Q23_16 = FixedPrecision<{.isSigned = true, .bits = 39, .power = -16}>;
+  using UQ4_4 = FixedPrecision<{.isSigned = false, .bits = 8, .power = 4}>;
+
+  given("fixed-point values") = [&]
+  {
+    then("they should convert to their exact floating point values") = [&]
+    {
+      ut::expect(static_cast<float>(Q7_8(static_cast<int16_t>(384))) == 1.5f);
+      ut::expect(static_cast<float>(Q7_8(static_cast<int16_t>(-1))) == -0.00390625f);
+      ut::expect(static_cast<float>(Q7_8(0)) == 0.0f);
+      ut::expect(static_cast<float>(UQ4_4(3U)) == 48.0f);
+      ut::expect(static_cast<double>(Q23_16(int64_t(-3) << 40)) == -3.0 * 16777216.0);
+    };
+  };
+
+  given("floating point values") = [&]
+  {
+    then("they should convert with each rounding policy") = [&]
+    {
+      // 2.5 and 3.5 units of the least significant bit are ties
+      float const twoAndAHalf = 2.5f / 256;
+      float const threeAndAHalf = 3.5f / 256;
+
+      ut::expect(Q7_8::FromFloat<RoundingPolicy::Truncate>(twoAndAHalf).data == 2);
+      ut::expect(Q7_8::FromFloat<RoundingPolicy::Truncate>(-twoAndAHalf).data == -2);
+      ut::expect(Q7_8::FromFloat<RoundingPolicy::Nearest>(twoAndAHalf).data == 3);
+      ut::expect(Q7_8::FromFloat<RoundingPolicy::Nearest>(-twoAndAHalf).data == -3);
+      ut::expect(Q7_8::FromFloat<RoundingPolicy::Convergent>(twoAndAHalf).data == 2);
+      ut::expect(Q7_8::FromFloat<RoundingPolicy::Convergent>(threeAndAHalf).data == 4);
+      ut::expect(Q7_8::FromFloat(1.5).data == 384);
+    };
+
+    then("out of range values should saturate, or wrap") = [&]
+    {
+      ut::expect(Q7_8::FromFloat(1000.0f).data == Q7_8::MaxData);
+      ut::expect(Q7_8::FromFloat(-1000.0f).data == Q7_8::MinData);
+      ut::expect(Q7_8::FromFloat(std::numeric_limits<float>::infinity()).data == 32767);
+      ut::expect(UQ8_8::FromFloat(-1.0f).data == 0U);
+      ut::expect(UQ8_8::FromFloat(std::numeric_limits<float>::quiet_NaN()).data == 0U);
+
+      // 128.0 is 0x8000, which wraps to the most negative 16-bit value
+      ut::expect(Q7_8::FromFloat<RoundingPolicy::Convergent, OverflowPolicy::Wrap>(128.0f).data == -32768);
+      ut::expect(UQ8_8::FromFloat<RoundingPolicy::Convergent, OverflowPolicy::Wrap>(-1.0f / 256).data == 0xFFFFU);
+    };
+  };
+
+  checkBulkConversion<Q7_8, RoundingPolicy::Convergent>("float arrays converted to Q7.8, rounding convergently");
+  checkBulkConversion<Q7_8, RoundingPolicy::Nearest>("float arrays converted to Q7.8, rounding to nearest");
+  checkBulkConversion<UQ8_8, RoundingPolicy::Truncate>("float arrays converted to UQ8.8, truncating");
+  checkBulkConversion<Q23_16, RoundingPolicy::Convergent>("float arrays converted to Q23.16, wider than a 32-bit lane");
+}
+
+void testDivisionByConstant()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0003: FixedPrecision division by compile-time constants multiplies by a reciprocal\n", reset));
+
+  using machine::FixedPrecision;
+
+  using Q7_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using UQ8_8 = FixedPrecision<{.isSigned = false, .bits = 16, .power = -8}>;
+  using Q3_12 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -12}>;
+  using UQ16_16 = FixedPrecision<{.isSigned = false, .bits = 32, .power = -16}>;
+  using Q31_32 = FixedPrecision<{.isSigned = true, .bits = 63, .power = -32}>;
+
+  given("integral dividends, including the extremes of each width") = [&]
+  {
+    std::vector<uint64_t> dividends = {0, 1, 2, 3, 7, 0x7FFF, 0x8000, 0xFFFF, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF,
+                                       0x7FFFFFFFFFFFFFFF, 0x8000000000000000, 0x8000000000000001, 0xFFFFFFFFFFFFFFFF};
+
+    for (int i = 0 ; i < 1000 ; ++i) dividends.push_back(Random() >> (Random() & 63));
+
+    then("the reciprocals should give exact quotients for every kind of divisor") = [&]
+    {
+      ut::expect(ReciprocalsAreExact<uint64_t(1), uint64_t(2), uint64_t(3), uint64_t(7), uint64_t(10), uint64_t(641),
+                                     uint64_t(0x100000001), uint64_t(0x7FFFFFFFFFFFFFFF), uint64_t(0x8000000000000000),
+                                     uint64_t(0x8000000000000001), uint64_t(0xFFFFFFFFFFFFFFFF)>(dividends));
+      ut::expect(ReciprocalsAreExact<int64_t(1), int64_t(-1), int64_t(3), int64_t(-3), int64_t(-4), int64_t(1000),
+                                     int64_t(0x7FFFFFFFFFFFFFFF), int64_t(-0x7FFFFFFFFFFFFFFF)>(dividends));
+      ut::expect(ReciprocalsAreExact<int32_t(7), int32_t(-10), uint32_t(7), int16_t(-641), uint8_t(3)>(dividends));
+    };
+  };
+
+  checkConstantQuotients<Q3_12(0x1800), Q7_8>("Q7.8 values divided by the constant Q3.12 1.5");
+  checkConstantQuotients<Q3_12(-0x0C00), Q7_8>("Q7.8 values divided by the constant Q3.12 -0.75");
+  checkConstantQuotients<UQ8_8(0x0100), UQ8_8>("UQ8.8 values divided by the constant UQ8.8 1.0");
+  checkConstantQuotients<UQ8_8(0x0A00), Q7_8>("Q7.8 values divided by the unsigned constant UQ8.8 10.0");
+  checkConstantQuotients<UQ16_16(0x0003243F), UQ16_16>("UQ16.16 values divided by the constant UQ16.16 pi");
+  checkConstantQuotients<Q7_8(-7), Q31_32>("Q31.32 values divided by the constant Q7.8 -7/256");
+}
+
+void testAdditionAndComparison()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0004: FixedPrecision sums, differences and comparisons align their operands at compile time\n", reset));
+
+  using machine::FixedPrecision;
+  using machine::FixedPrecisionTraits;
+  using machine::SumTraits;
+
+  using Q7_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using Q3_12 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -12}>;
+  using UQ8_8 = FixedPrecision<{.isSigned = false, .bits = 16, .power = -8}>;
+  using UQ4_4 = FixedPrecision<{.isSigned = false, .bits = 8, .power = 4}>;
+  using Q1_60 = FixedPrecision<{.isSigned = true, .bits = 61, .power = -60}>;
+  using UQ64_0 = FixedPrecision<{.isSigned = false, .bits = 64, .power = 0, .maxBits = 64}>;
+
+  constexpr auto Equal = [](FixedPrecisionTraits const & lhs, FixedPrecisionTraits const & rhs) {
+    return lhs.isSigned == rhs.isSigned && lhs.bits == rhs.bits && lhs.power == rhs.power && lhs.minBits == rhs.minBits && lhs.maxBits == rhs.maxBits;
+  };
+
+  // Q7.8 + Q3.12 spans 2^-12 to 2^7, plus a carry: Q8.12
+  static_assert(Equal(SumTraits<Q7_8::Traits, Q3_12::Traits>(), {.isSigned = true, .bits = 20, .power = -12, .minBits = 15}));
+  static_assert(Equal(SumTraits<UQ8_8::Traits, UQ8_8::Traits>(), {.isSigned = false, .bits = 17, .power = -8, .minBits = 16}));
+  // The difference of unsigned operands is signed, and needs no carry
+  static_assert(Equal(SumTraits<UQ8_8::Traits, UQ8_8::Traits, true>(), {.isSigned = true, .bits = 16, .power = -8, .minBits = 16}));
+  // Beyond maxBits, the least significant bits are dropped
+  static_assert(Equal(SumTraits<Q1_60::Traits, UQ4_4::Traits>(), {.isSigned = true, .bits = 63, .power = -50, .minBits = 61}));
+  static_assert(std::is_same_v<decltype(Q7_8() + Q3_12()), FixedPrecision<SumTraits<Q7_8::Traits, Q3_12::Traits>()>>);
+
+  given("values of different traits") = [&]
+  {
+    constexpr std::size_t Count = 1000;
+
+    auto const q7_8 = RandomValues<Q7_8>(Count);
+    auto const q3_12 = RandomValues<Q3_12>(Count);
+    auto const uq8_8 = RandomValues<UQ8_8>(Count);
+    auto const uq4_4 = RandomValues<UQ4_4>(Count);
+
+    then("sums and differences should be exact") = [&]
+    {
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i < Count ; ++i) {
+        double const a = static_cast<double>(static_cast<Q7_8::Float64>(q7_8[i]));
+        double const b = static_cast<double>(static_cast<Q3_12::Float64>(q3_12[i]));
+        double const c = static_cast<double>(static_cast<UQ8_8::Float64>(uq8_8[i]));
+        double const d = static_cast<double>(static_cast<UQ4_4::Float64>(uq4_4[i]));
+
+        auto const AsDouble = [](auto const value) { return static_cast<double>(static_cast<typename decltype(value)::Float64>(value)); };
+
+        mismatches += AsDouble(q7_8[i] + q3_12[i]) != a + b;
+        mismatches += AsDouble(q7_8[i] - q3_12[i]) != a - b;
+        mismatches += AsDouble(uq8_8[i] - uq4_4[i]) != c - d;
+        mismatches += AsDouble(uq4_4[i] + q7_8[i]) != d + a;
+        mismatches += AsDouble(q7_8[i] + q3_12[i] - uq8_8[i]) != a + b - c;
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+
+    then("comparisons should order the values represented") = [&]
+    {
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i < Count ; ++i) {
+        double const a = static_cast<double>(static_cast<Q7_8::Float64>(q7_8[i]));
+        double const b = static_cast<double>(static_cast<Q3_12::Float64>(q3_12[i]));
+        double const c = static_cast<double>(static_cast<UQ8_8::Float64>(uq8_8[i]));
+
+        mismatches += (q7_8[i] < q3_12[i]) != (a < b);
+        mismatches += (q3_12[i] <= uq8_8[i]) != (b <= c);
+        mismatches += (uq8_8[i] > q7_8[i]) != (c > a);
+        mismatches += (q7_8[i] == uq8_8[i]) != (a == c);
+        mismatches += (q7_8[i] != q7_8[i]);
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("equal values at different powers, and operands whose alignment exceeds 64 bits") = [&]
+  {
+    then("comparisons should be exact") = [&]
+    {
+      ut::expect(Q7_8(384) == Q3_12(6144));
+      ut::expect(Q7_8(-384) == Q3_12(-6144));
+      ut::expect(Q7_8(384) < Q3_12(6145));
+      ut::expect(UQ4_4(1U) == UQ8_8(4096U));
+      ut::expect(Q7_8(-1) < UQ8_8(0U));
+
+      // 2^-60 and 2^63 + 1
+      ut::expect(Q1_60(1) > UQ4_4(0U));
+      ut::expect(Q1_60(-1) < UQ4_4(0U));
+      ut::expect(Q1_60(int64_t(1) << 60) < UQ64_0((uint64_t(1) << 63) + 1));
+      ut::expect(UQ64_0(~uint64_t(0)) > Q1_60(Q1_60::MaxData));
+      ut::expect(UQ64_0(1U) == Q1_60(int64_t(1) << 60));
+
+      // -1 and the MinData of a finer operand, -2^-13, whose magnitude is 2^bits
+      using Q7_0 = machine::FixedPrecision<{.isSigned = true, .bits = 7, .power = 0}>;
+      using Q7_20 = machine::FixedPrecision<{.isSigned = true, .bits = 7, .power = -20}>;
+
+      ut::expect(Q7_0(-1) < Q7_20(Q7_20::MinData));
+      ut::expect(Q7_0(-1) != Q7_20(Q7_20::MinData));
+      ut::expect(Q7_20(Q7_20::MinData) > Q7_0(-1));
+      ut::expect(Q7_0(0) > Q7_20(Q7_20::MinData));
+      ut::expect(Q1_60(Q1_60::MinData) == Q7_0(-2));
+    };
+  };
+
+  given("an accumulator") = [&]
+  {
+    Q7_8 sum(0);
+
+    then("compound assignment should keep its traits, aligning the operand to them") = [&]
+    {
+      sum += Q7_8(256);         // 1.0
+      sum += Q3_12(0x0800);     // 0.5
+      sum -= UQ4_4(1U);         // 16.0
+      sum += Q3_12(0x0001);     // 2^-12, finer than the accumulator
+
+      static_assert(std::is_same_v<decltype(sum += Q3_12()), Q7_8 &>);
+
+      ut::expect(sum.data == 384 - 4096);
+    };
+  };
+}
+
+void testRoundingAndOverflowPolicies()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0005: FixedPrecision traits select the rounding and overflow policies of their arithmetic\n", reset));
+
+  using machine::FixedPrecision;
+  using machine::RoundingPolicy;
+  using machine::OverflowPolicy;
+
+  // Products of these are held in 15 bits, rounding off 15
+  using Q7_8T = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .maxBits = 15, .rounding = RoundingPolicy::Truncate}>;
+  using Q7_8N = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .maxBits = 15, .rounding = RoundingPolicy::Nearest}>;
+  using Q7_8C = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .maxBits = 15, .rounding = RoundingPolicy::Convergent}>;
+
+  using Q7_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using Q7_8S = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .overflow = OverflowPolicy::Saturate}>;
+  using Q7_8X = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .overflow = OverflowPolicy::Trap}>;
+  using UQ8_8S = FixedPrecision<{.isSigned = false, .bits = 16, .power = -8, .overflow = OverflowPolicy::Saturate}>;
+  using Q3_12 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -12}>;
+  using Q31_32S = FixedPrecision<{.isSigned = true, .bits = 63, .power = -32, .overflow = OverflowPolicy::Saturate}>;
+  using Q31_32N = FixedPrecision<{.isSigned = true, .bits = 63, .power = -32, .rounding = RoundingPolicy::Nearest}>;
+
+  // Quotients of these have 31 bits, so that their ratios are exact enough in double precision to find ties
+  using Q7_8T31 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .maxBits = 31, .rounding = RoundingPolicy::Truncate}>;
+  using Q7_8N31 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .maxBits = 31, .rounding = RoundingPolicy::Nearest}>;
+  using Q7_8C31 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .maxBits = 31, .rounding = RoundingPolicy::Convergent}>;
+
+  static_assert(machine::ProductTraits<Q7_8S::Traits, Q7_8::Traits>().overflow == OverflowPolicy::Saturate);
+  static_assert(machine::SumTraits<Q7_8X::Traits, Q7_8S::Traits>().overflow == OverflowPolicy::Trap);
+  static_assert(machine::QuotientTraits<Q7_8T::Traits, Q7_8C::Traits>().rounding == RoundingPolicy::Convergent);
+
+  // Rounds value / 2^shift, or numerator / denominator, by the reference functions of <cmath>
+  auto const RoundedRatio = [](RoundingPolicy const rounding, double const ratio) {
+    return rounding == RoundingPolicy::Truncate ? std::trunc(ratio) : rounding == RoundingPolicy::Nearest ? std::round(ratio) : std::nearbyint(ratio);
+  };
+
+  given("products held in fewer bits than they have") = [&]
+  {
+    auto const lhs = RandomValues<Q7_8T>(1000);
+    auto const rhs = RandomValues<Q7_8T>(1000);
+
+    then("they should round according to the operands' policy") = [&]
+    {
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i < lhs.size() ; ++i) {
+        double const exact = static_cast<double>(lhs[i].data) * static_cast<double>(rhs[i].data) / 32768.0;
+
+        mismatches += (lhs[i] * rhs[i]).data != RoundedRatio(RoundingPolicy::Truncate, exact);
+        mismatches += (Q7_8N(lhs[i].data) * Q7_8N(rhs[i].data)).data != RoundedRatio(RoundingPolicy::Nearest, exact);
+        mismatches += (Q7_8C(lhs[i].data) * Q7_8C(rhs[i].data)).data != RoundedRatio(RoundingPolicy::Convergent, exact);
+      }
+
+      ut::expect(mismatches == 0U);
+
+      // Ties: 3 * 2^14 / 2^15 = 1.5 and -1.5
+      ut::expect((Q7_8N(3) * Q7_8N(1 << 14)).data == 2);
+      ut::expect((Q7_8N(-3) * Q7_8N(1 << 14)).data == -2);
+      ut::expect((Q7_8C(5) * Q7_8C(1 << 14)).data == 2);
+      ut::expect((Q7_8C(-5) * Q7_8C(1 << 14)).data == -2);
+      ut::expect((Q7_8T(-3) * Q7_8T(1 << 14)).data == -1);
+    };
+
+    then("products beyond 64 bits should round from their 128-bit value") = [&]
+    {
+      auto const wide = RandomValues<Q31_32N>(1000);
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i + 1 < wide.size() ; ++i) {
+        __int128 const product = static_cast<__int128>(wide[i].data) * wide[i + 1].data;
+        __int128 const divisor = static_cast<__int128>(1) << 63;
+        __int128 const quotient = product / divisor;
+        __int128 const remainder = product % divisor;
+        __int128 const nearest = quotient + (2 * (remainder < 0 ? -remainder : remainder) >= divisor ? (product < 0 ? -1 : 1) : 0);
+
+        mismatches += (wide[i] * wide[i + 1]).data != static_cast<int64_t>(nearest);
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("quotients") = [&]
+  {
+    auto const dividends = RandomValues<Q7_8T31>(1000);
+    auto const divisors = RandomValues<Q7_8T31>(1000, true);
+
+    then("they should round according to the operands' policy, by operator/ and DivideBy") = [&]
+    {
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i < dividends.size() ; ++i) {
+        double const exact = static_cast<double>(int64_t(dividends[i].data) << 16) / static_cast<double>(divisors[i].data);
+
+        mismatches += (dividends[i] / divisors[i]).data != RoundedRatio(RoundingPolicy::Truncate, exact);
+        mismatches += (Q7_8N31(dividends[i].data) / Q7_8N31(divisors[i].data)).data != RoundedRatio(RoundingPolicy::Nearest, exact);
+        mismatches += (Q7_8C31(dividends[i].data) / Q7_8C31(divisors[i].data)).data != RoundedRatio(RoundingPolicy::Convergent, exact);
+
+        double const byConstant = static_cast<double>(int64_t(dividends[i].data) << 16) / -3.0;
+
+        mismatches += machine::DivideBy<Q7_8N31(-3)>(Q7_8N31(dividends[i].data)).data != RoundedRatio(RoundingPolicy::Nearest, byConstant);
+        mismatches += machine::DivideBy<Q7_8C31(-3)>(Q7_8C31(dividends[i].data)).data != RoundedRatio(RoundingPolicy::Convergent, byConstant);
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("accumulators with each overflow policy") = [&]
+  {
+    then("saturating accumulators should stop at their bounds") = [&]
+    {
+      Q7_8S sum(Q7_8S::MaxData - 1);
+      sum += Q7_8(256);
+      ut::expect(sum.data == Q7_8S::MaxData);
+
+      sum -= Q3_12(Q3_12::MaxData);
+      ut::expect(sum.data == Q7_8S::MaxData - 2047);
+
+      Q7_8S low(Q7_8S::MinData + 1);
+      low -= Q7_8S(2);
+      ut::expect(low.data == Q7_8S::MinData);
+
+      UQ8_8S unsignedSum(1U);
+      unsignedSum -= Q7_8(2);
+      ut::expect(unsignedSum.data == 0U);
+      unsignedSum += Q7_8(-1);
+      ut::expect(unsignedSum.data == 0U);
+
+      // Overflowing the 64-bit integral itself
+      Q31_32S full(Q31_32S::MaxData);
+      full += Q31_32S(Q31_32S::MaxData);
+      ut::expect(full.data == Q31_32S::MaxData);
+      full = Q31_32S(Q31_32S::MinData);
+      full -= Q31_32S(1);
+      ut::expect(full.data == Q31_32S::MinData);
+
+      // An operand whose alignment exceeds 64 bits
+      Q7_8S fromWide(0);
+      fromWide += FixedPrecision<{.isSigned = true, .bits = 8, .power = 60}>(int8_t(-1));
+      ut::expect(fromWide.data == Q7_8S::MinData);
+    };
+
+    then("wrapping accumulators should wrap as their integral does, and trapping ones should not trap in range") = [&]
+    {
+      Q7_8 wrapped(Q7_8::MaxData);
+      wrapped += Q7_8(1);
+      ut::expect(wrapped.data == Q7_8::MaxData + 1);
+
+      Q7_8X trapped(100);
+      trapped += Q7_8(Q7_8::MaxData - 100);
+      trapped -= Q7_8(Q7_8::MaxData);
+      ut::expect(trapped.data == 0);
+      ut::expect(Q7_8X::FromFloat<RoundingPolicy::Convergent, OverflowPolicy::Trap>(-128.0).data == Q7_8X::MinData);
+    };
+  };
+
+  given("quotients of the most negative value by -1") = [&]
+  {
+    using Q7_8S48 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .maxBits = 48, .overflow = OverflowPolicy::Saturate}>;
+
+    then("saturating quotients should saturate, by the operator, the constant divide and the array kernel") = [&]
+    {
+      using Quotient = machine::QuotientOf<Q7_8S, Q7_8S>;
+
+      ut::expect((Q7_8S(Q7_8S::MinData) / Q7_8S(-1)).data == Quotient::MaxData);
+      ut::expect(machine::DivideBy<Q7_8S(-1)>(Q7_8S(Q7_8S::MinData)).data == Quotient::MaxData);
+      ut::expect((Q7_8S(Q7_8S::MaxData) / Q7_8S(-1)).data == -(Q7_8S(Q7_8S::MaxData) / Q7_8S(1)).data);
+
+      std::vector<Q7_8S48> const dividends(16, Q7_8S48(Q7_8S48::MinData));
+      std::vector<Q7_8S48> const divisors(16, Q7_8S48(-1));
+      std::vector<machine::QuotientOf<Q7_8S48, Q7_8S48>> quotients(16);
+
+      machine::Divide(dividends, divisors, quotients);
+      ut::expect(std::all_of(quotients.begin(), quotients.end(), [](auto const quotient) { return quotient.data == decltype(quotient)::MaxData; }));
+    };
+
+    then("wrapping quotients should wrap, and trapping ones should not trap in range") = [&]
+    {
+      ut::expect((Q7_8(Q7_8::MinData) / Q7_8(-1)).data == machine::QuotientOf<Q7_8, Q7_8>::MinData);
+      ut::expect(machine::DivideBy<Q7_8(-1)>(Q7_8(Q7_8::MinData)).data == machine::QuotientOf<Q7_8, Q7_8>::MinData);
+
+      ut::expect((Q7_8X(Q7_8X::MaxData) / Q7_8X(-1)).data == -(Q7_8X(Q7_8X::MaxData) / Q7_8X(1)).data);
+      ut::expect(machine::DivideBy<Q7_8X(-1)>(Q7_8X(Q7_8X::MaxData)).data == -(Q7_8X(Q7_8X::MaxData) / Q7_8X(1)).data);
+      ut::expect((Q7_8X(Q7_8X::MinData) / Q7_8X(1)).data == machine::QuotientOf<Q7_8X, Q7_8X>::MinData);
+    };
+  };
+
+  given("conversions between traits") = [&]
+  {
+    then("they should round the bits dropped, and fit the target's bits") = [&]
+    {
+      using Q7_8NS = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .rounding = RoundingPolicy::Nearest, .overflow = OverflowPolicy::Saturate}>;
+      using Q7_8CS = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .rounding = RoundingPolicy::Convergent, .overflow = OverflowPolicy::Saturate}>;
+
+      // 0x0018 is 1.5 units of Q7.8
+      ut::expect(Q7_8::FromFixed(Q3_12(0x0018)).data == 1);
+      ut::expect(Q7_8::FromFixed(Q3_12(-0x0018)).data == -1);
+      ut::expect(Q7_8NS::FromFixed(Q3_12(0x0018)).data == 2);
+      ut::expect(Q7_8NS::FromFixed(Q3_12(-0x0008)).data == -1);
+      ut::expect(Q7_8CS::FromFixed(Q3_12(0x0028)).data == 2);
+      ut::expect(Q7_8CS::FromFixed(Q3_12(-0x0018)).data == -2);
+
+      ut::expect(Q7_8NS::FromFixed(Q31_32S(int64_t(1000) << 32)).data == Q7_8NS::MaxData);
+      ut::expect(Q7_8NS::FromFixed(Q31_32S(int64_t(-1000) << 32)).data == Q7_8NS::MinData);
+      ut::expect(Q7_8NS::FromFixed(Q31_32S(int64_t(-100) << 32)).data == -100 * 256);
+      ut::expect(UQ8_8S::FromFixed(Q7_8(-1)).data == 0U);
+      ut::expect(Q3_12::FromFixed(Q7_8(-3)).data == -3 * 16);
+    };
+  };
+
+  checkSaturatingAccumulation<Q7_8S, Q7_8S>("saturating Q7.8 x Q7.8 products accumulated by the array kernel");
+  checkSaturatingAccumulation<UQ8_8S, Q7_8>("saturating UQ8.8 x Q7.8 products accumulated by the array kernel");
+}
+
+void testElementaryFunctions()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0006: Elementary functions of FixedPrecision values are within 1 ulp of their result traits\n", reset));
+
+  using machine::FixedPrecision;
+  using machine::RoundingPolicy;
+
+  using Q3_28 = FixedPrecision<{.isSigned = true, .bits = 31, .power = -28}>;
+  using Q10_52 = FixedPrecision<{.isSigned = true, .bits = 62, .power = -52}>;
+  using Q7_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using UQ16_16 = FixedPrecision<{.isSigned = false, .bits = 32, .power = -16}>;
+  using UQ0_48 = FixedPrecision<{.isSigned = false, .bits = 48, .power = -48}>;
+
+  // Results in 56 or 48 fractional bits, rounded to nearest
+  using Q1_56 = FixedPrecision<{.isSigned = true, .bits = 58, .power = -56, .rounding = RoundingPolicy::Nearest}>;
+  using Q2_55 = FixedPrecision<{.isSigned = true, .bits = 58, .power = -55, .rounding = RoundingPolicy::Nearest}>;
+  using Q9_48 = FixedPrecision<{.isSigned = true, .bits = 58, .power = -48, .rounding = RoundingPolicy::Nearest}>;
+  using UQ0_56 = FixedPrecision<{.isSigned = false, .bits = 56, .power = -56, .rounding = RoundingPolicy::Nearest}>;
+
+  given("angles in radians") = [&]
+  {
+    auto const angles = RandomValues<Q3_28>(10000);
+    auto const wide = RandomValues<Q10_52>(10000);
+
+    then("sin and cos should be within 1 ulp, in the default and in 56 fractional bits") = [&]
+    {
+      auto const sin = [](long double const x) { return std::sin(x); };
+      auto const cos = [](long double const x) { return std::cos(x); };
+
+      ut::expect(WorstError(angles, [](auto const x) { return machine::Sin(x); }, sin) <= 1.0L);
+      ut::expect(WorstError(angles, [](auto const x) { return machine::Cos(x); }, cos) <= 1.0L);
+      ut::expect(WorstError(wide, [](auto const x) { return machine::Sin<Q1_56::Traits>(x); }, sin) <= 1.0L);
+      ut::expect(WorstError(wide, [](auto const x) { return machine::Cos<Q1_56::Traits>(x); }, cos) <= 1.0L);
+    };
+
+    then("the batch variants should match the scalar functions") = [&]
+    {
+      std::vector<FixedPrecision<machine::UnitTraits>> sines(angles.size());
+      machine::Sin(angles, sines);
+
+      std::size_t mismatches = 0;
+      for (std::size_t i = 0 ; i < angles.size() ; ++i) mismatches += sines[i] != machine::Sin(angles[i]);
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("points of differing traits") = [&]
+  {
+    auto const ys = RandomValues<Q7_8>(10000);
+    auto const xs = RandomValues<UQ16_16>(10000);
+    auto const negatives = RandomValues<Q3_28>(10000);
+
+    then("atan2 should be within 1 ulp in every quadrant") = [&]
+    {
+      long double worst = 0;
+
+      for (std::size_t i = 0 ; i < ys.size() ; ++i) {
+        long double const y = std::ldexp(static_cast<long double>(ys[i].data), -8);
+        long double const x = std::ldexp(static_cast<long double>(xs[i].data), -16);
+        long double const negative = std::ldexp(static_cast<long double>(negatives[i].data), -28);
+
+        worst = std::max(worst, std::fabs(std::ldexp(static_cast<long double>(machine::Atan2(ys[i], xs[i]).data), -29) - std::atan2(y, x)) * (1 << 29));
+        worst = std::max(worst, std::fabs(std::ldexp(static_cast<long double>(machine::Atan2<Q2_55::Traits>(ys[i], negatives[i]).data), -55) -
+                                          std::atan2(y, negative)) * std::ldexp(1.0L, 55));
+      }
+
+      ut::expect(worst <= 1.0L);
+    };
+
+    then("the axes should give correctly rounded angles") = [&]
+    {
+      auto const Rounded = [](long double const angle) { return std::llround(std::ldexp(angle, 29)); };
+      long double const pi = std::acos(-1.0L);
+
+      ut::expect(machine::Atan2(Q7_8(0), Q7_8(0)).data == 0);
+      ut::expect(machine::Atan2(Q7_8(0), Q7_8(256)).data == 0);
+      ut::expect(machine::Atan2(Q7_8(0), Q7_8(-256)).data == Rounded(pi));
+      ut::expect(machine::Atan2(Q7_8(-1), Q7_8(-256)).data == Rounded(std::atan2(-1.0L, -256.0L)));
+      ut::expect(machine::Atan2(Q7_8(256), Q7_8(0)).data == Rounded(pi / 2));
+      ut::expect(machine::Atan2(Q7_8(-256), Q7_8(256)).data == Rounded(-pi / 4));
+    };
+  };
+
+  given("exponentials and logarithms") = [&]
+  {
+    auto const exponents = RandomValues<Q7_8>(10000);
+    auto const fractions = RandomValues<UQ0_48>(10000, true);
+    auto const values = RandomValues<UQ16_16>(10000, true);
+
+    then("exp should be within 1 ulp, and saturate beyond its result") = [&]
+    {
+      std::vector<Q7_8> inRange;
+      std::copy_if(exponents.begin(), exponents.end(), std::back_inserter(inRange), [](Q7_8 const x) { return x.data < 11 * 256; });
+
+      ut::expect(WorstError(inRange, [](auto const x) { return machine::Exp(x); }, [](long double const x) { return std::exp(x); }) <= 1.0L);
+      ut::expect(WorstError(inRange, [](auto const x) { return machine::Exp<UQ0_56::Traits>(Q7_8(x.data < 0 ? x.data : -x.data)); },
+                            [](long double const x) { return std::exp(-std::fabs(x)); }) <= 1.0L);
+
+      ut::expect(machine::Exp(Q7_8(Q7_8::MaxData)).data == FixedPrecision<machine::ExponentialTraits>::MaxData);
+      ut::expect(machine::Exp(Q7_8(Q7_8::MinData)).data == 0U);
+    };
+
+    then("log2 should be within 1 ulp, and give MinData for non-positive values") = [&]
+    {
+      auto const log2 = [](long double const x) { return std::log2(x); };
+
+      ut::expect(WorstError(values, [](auto const x) { return machine::Log2(x); }, log2) <= 1.0L);
+      ut::expect(WorstError(fractions, [](auto const x) { return machine::Log2<Q9_48::Traits>(x); }, log2) <= 1.0L);
+      ut::expect(machine::Log2(UQ16_16(1 << 16)).data == 0);
+      ut::expect(machine::Log2(UQ16_16(1 << 20)).data == 4 << 23);
+      ut::expect(machine::Log2(Q7_8(0)).data == FixedPrecision<machine::LogarithmTraits>::MinData);
+      ut::expect(machine::Log2(Q7_8(-1)).data == FixedPrecision<machine::LogarithmTraits>::MinData);
+    };
+  };
+
+  given("square roots") = [&]
+  {
+    auto const values = RandomValues<UQ16_16>(10000);
+    auto const fractions = RandomValues<UQ0_48>(10000);
+
+    then("they should be exact, rounded to the result's power") = [&]
+    {
+      auto const sqrt = [](long double const x) { return std::sqrt(x); };
+
+      static_assert(machine::SqrtTraits<UQ16_16::Traits>().power == -24);
+
+      ut::expect(WorstError(values, [](auto const x) { return machine::Sqrt(x); }, sqrt) < 1.0L);
+      ut::expect(WorstError(fractions, [](auto const x) { return machine::Sqrt<UQ0_56::Traits>(x); }, sqrt) <= 0.5L);
+      ut::expect(machine::Sqrt(UQ16_16(4 << 16)).data == 2U << 24);
+      ut::expect(machine::Sqrt(Q7_8(-1)).data == 0U);
+    };
+  };
+}
+
+void testLinearKernels()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0007: Dot products, FIR filters and matrix products size their accumulators from the number of terms\n", reset));
+
+  using machine::FixedPrecision;
+  using machine::AccumulatorOf;
+
+  using Q1_14 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -14}>;
+  using Q7_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using UQ16_16 = FixedPrecision<{.isSigned = false, .bits = 32, .power = -16}>;
+  using Q10_30 = FixedPrecision<{.isSigned = true, .bits = 40, .power = -30}>;
+
+  given("a 63-tap filter of Q1.14 taps and samples") = [&]
+  {
+    using Output = AccumulatorOf<Q1_14, Q1_14, 63>;
+
+    static_assert(Output::Traits.bits == 36 && Output::Traits.power == -28);
+
+    auto const randomTaps = RandomValues<Q1_14>(63);
+    auto const samples = RandomValues<Q1_14>(1003);
+
+    std::array<Q1_14, 63> taps;
+    std::copy(randomTaps.begin(), randomTaps.end(), taps.begin());
+
+    then("the outputs should be the exact sums of the products") = [&]
+    {
+      std::vector<Output> outputs(samples.size() - taps.size() + 1);
+      machine::Fir(taps, samples, outputs);
+
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i < outputs.size() ; ++i) {
+        mismatches += outputs[i].data != ExactSum(taps.data(), taps.size(), samples.data() + i + taps.size() - 1, -1);
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+
+    then("the dot product should be sized by the static extent, or by the given number of terms") = [&]
+    {
+      std::span<Q1_14 const, 63> const window(samples.data(), 63);
+
+      ut::expect(machine::Dot(taps, window).data == ExactSum(taps.data(), 63, samples.data(), 1));
+      ut::expect(machine::Dot<64>(std::span(samples).first(50), std::span(randomTaps).first(50)).data ==
+                 ExactSum(samples.data(), 50, randomTaps.data(), 1));
+      static_assert(std::same_as<decltype(machine::Dot<64>(samples, samples)), AccumulatorOf<Q1_14, Q1_14, 64>>);
+    };
+  };
+
+  given("small matrices of differing traits") = [&]
+  {
+    auto const matrix = RandomValues<UQ16_16>(13 * 10);
+    auto const vector = RandomValues<Q7_8>(10);
+    auto const lhs = RandomValues<Q7_8>(5 * 7);
+    auto const rhs = RandomValues<Q7_8>(7 * 19);
+
+    then("gemv and gemm should give the exact sums of the products") = [&]
+    {
+      std::vector<AccumulatorOf<UQ16_16, Q7_8, 10>> results(13);
+      machine::Gemv<10>(matrix, vector, results);
+
+      std::vector<AccumulatorOf<Q7_8, Q7_8, 7>> products(5 * 19);
+      machine::Gemm<5, 7, 19>(lhs, rhs, products);
+
+      std::size_t mismatches = 0;
+
+      for (std::size_t r = 0 ; r < 13 ; ++r) {
+        mismatches += results[r].data != ExactSum(matrix.data() + r * 10, 10, vector.data(), 1);
+      }
+
+      for (std::size_t r = 0 ; r < 5 ; ++r) {
+        for (std::size_t j = 0 ; j < 19 ; ++j) {
+          mismatches += products[r * 19 + j].data != ExactSum(lhs.data() + r * 7, 7, rhs.data() + j, 19);
+        }
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("accumulators beyond maxBits") = [&]
+  {
+    using Sum = AccumulatorOf<Q10_30, Q10_30, 16>;
+    using Saturating = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .overflow = machine::OverflowPolicy::Saturate}>;
+
+    static_assert(Sum::Traits.bits == 63 && Sum::Traits.power == -60 + 84 - 63);
+
+    auto const lhs = RandomValues<Q10_30>(16);
+    auto const rhs = RandomValues<Q10_30>(16);
+
+    then("the exact sum should be rounded once, by the accumulator's policy") = [&]
+    {
+      ut::expect(machine::Dot<16>(lhs, rhs).data == ExactSum(lhs.data(), 16, rhs.data(), 1) / (__int128(1) << 21));
+    };
+
+    then("the sum of the products of the most negative values should be fitted by the overflow policy") = [&]
+    {
+      std::array<Saturating, 2> const minima = {Saturating(Saturating::MinData), Saturating(Saturating::MinData)};
+
+      ut::expect(machine::Dot(minima, minima).data == AccumulatorOf<Saturating, Saturating, 2>::MaxData);
+    };
+
+    then("the fitted sum should hold at the 63-bit boundary, where the extra bit of those products leaves 64-bit lanes") = [&]
+    {
+      using Q1_31 = FixedPrecision<{.isSigned = true, .bits = 31, .power = -31, .overflow = machine::OverflowPolicy::Saturate}>;
+
+      std::array<Q1_31, 2> const minima = {Q1_31(Q1_31::MinData), Q1_31(Q1_31::MinData)};
+
+      ut::expect(machine::Dot(minima, minima).data == AccumulatorOf<Q1_31, Q1_31, 2>::MaxData);
+    };
+  };
+}
+
+void testFusedExpressions()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0008: Fused expressions of FixedPrecision values are computed exactly and rounded once\n", reset));
+
+  using machine::FixedPrecision;
+  using machine::Fused;
+  using machine::RoundingPolicy;
+
+  using Q7_8 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8}>;
+  using UQ8_8 = FixedPrecision<{.isSigned = false, .bits = 16, .power = -8}>;
+  using Q1_14 = FixedPrecision<{.isSigned = true, .bits = 15, .power = -14}>;
+  using Q10_30 = FixedPrecision<{.isSigned = true, .bits = 40, .power = -30}>;
+
+  auto const a = RandomValues<Q7_8>(1000);
+  auto const b = RandomValues<Q1_14>(1000);
+  auto const c = RandomValues<UQ8_8>(1000);
+  auto const d = RandomValues<Q7_8>(1000);
+
+  given("expressions within maxBits") = [&]
+  {
+    then("they should have the traits, and the values, of the scalar operators") = [&]
+    {
+      static_assert(std::same_as<decltype(machine::Evaluate(Fused(a[0]) * b[0] + Fused(c[0]) * d[0] - Fused(a[0]) * d[0])),
+                                 decltype(a[0] * b[0] + c[0] * d[0] - a[0] * d[0])>);
+
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i < a.size() ; ++i) {
+        mismatches += machine::Evaluate(Fused(a[i]) * b[i] + Fused(c[i]) * d[i] - Fused(a[i]) * d[i]) != a[i] * b[i] + c[i] * d[i] - a[i] * d[i];
+        mismatches += machine::Evaluate(a[i] * Fused(b[i]) * c[i]) != a[i] * b[i] * c[i];
+        mismatches += machine::Evaluate((Fused(a[i]) - c[i]) * d[i] + b[i]) != (a[i] - c[i]) * d[i] + b[i];
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+
+    then("initializing a narrower value should round once, as FromFixed") = [&]
+    {
+      using Nearest = FixedPrecision<{.isSigned = true, .bits = 15, .power = -8, .rounding = RoundingPolicy::Nearest,
+                                      .overflow = machine::OverflowPolicy::Saturate}>;
+
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i < a.size() ; ++i) {
+        Nearest const fused = Fused(a[i]) * b[i] + Fused(c[i]) * d[i];
+        mismatches += fused.data != Nearest::FromFixed(a[i] * b[i] + c[i] * d[i]).data;
+
+        Q7_8 assigned;
+        assigned = Fused(a[i]) * d[i] - b[i];
+        mismatches += assigned.data != Q7_8::FromFixed(a[i] * d[i] - b[i]).data;
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("products beyond maxBits") = [&]
+  {
+    using Q22_40 = FixedPrecision<{.isSigned = true, .bits = 62, .power = -40}>;
+
+    auto const x = RandomValues<Q10_30>(1000);
+    auto const y = RandomValues<Q10_30>(1000);
+
+    then("the exact sum should be computed in 128 bits, and truncated once") = [&]
+    {
+      std::size_t mismatches = 0;
+
+      for (std::size_t i = 0 ; i + 1 < x.size() ; ++i) {
+        Q22_40 const fused = Fused(x[i]) * y[i] - Fused(x[i + 1]) * y[i + 1];
+
+        __int128 const exact = static_cast<__int128>(x[i].data) * y[i].data - static_cast<__int128>(x[i + 1].data) * y[i + 1].data;
+        mismatches += fused.data != static_cast<int64_t>(exact / (__int128(1) << 20));
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("sums of products whose exact width reaches 126 bits") = [&]
+  {
+    using Q31_31 = FixedPrecision<{.isSigned = true, .bits = 62, .power = -31, .maxBits = 127}>;
+
+    Q31_31 const x = Q31_31::FromFloat(3.0);
+    Q31_31 const y = Q31_31::FromFloat(5.0);
+
+    then("they should be computed exactly at the power of their terms") = [&]
+    {
+      static_assert(decltype(Fused(x) * y + Fused(x) * y)::ExactTraits.bits == 125);
+      static_assert(decltype(Fused(x) * y + Fused(x) * y - Fused(x) * y)::ExactTraits.bits == 126);
+      static_assert(decltype(Fused(x) * y + Fused(x) * y - Fused(x) * y)::ExactTraits.power == -62);
+
+      Q31_31 const sum = Fused(x) * y + Fused(x) * y;
+      Q31_31 const difference = Fused(x) * y + Fused(x) * y - Fused(y) * y;
+
+      ut::expect(sum == Q31_31::FromFloat(30.0));
+      ut::expect(difference == Q31_31::FromFloat(5.0));
+    };
+  };
+}
+
+void testWideIntegrals()
+{
+  /////////////////////////////////////////////////////////////////////////////
+
+  ut_helper::log(text::concatenate(
+      bold_cyan, "ERD-FIXED-0009: FixedPrecision data and products of up to 128 bits are held exactly in 128-bit integrals\n", reset));
+
+  using machine::FixedPrecision;
+  using machine::RoundingPolicy;
+
+  using Q32_32 = FixedPrecision<{.isSigned = true, .bits = 63, .power = -32, .maxBits = 127}>;
+  using UQ32_32 = FixedPrecision<{.isSigned = false, .bits = 64, .power = -32, .maxBits = 128}>;
+  using UQ64_64 = FixedPrecision<{.isSigned = false, .bits = 128, .power = -64, .maxBits = 128}>;
+  using Q31_32 = FixedPrecision<{.isSigned = true, .bits = 63, .power = -32, .maxBits = 127, .rounding = RoundingPolicy::Nearest}>;
+  using Q63_64 = FixedPrecision<{.isSigned = true, .bits = 127, .power = -64, .maxBits = 127, .rounding = RoundingPolicy::Nearest}>;
+
+  auto const Wide = [](int const bits) {
+    unsigned __int128 const value = static_cast<unsigned __int128>(Random()) << 64 | Random();
+    return bits == 128 ? value : value & ((static_cast<unsigned __int128>(1) << bits) - 1);
+  };
+
+  given("traits of more than 64 bits") = [&]
+  {
+    then("they should select the 128-bit integrals") = [&]
+    {
+      static_assert(std::same_as<decltype(machine::FastestIntegralType<{.isSigned = true, .bits = 100, .maxBits = 127}>()), __int128>);
+      static_assert(std::same_as<decltype(machine::FastestIntegralType<{.isSigned = false, .bits = 128, .maxBits = 128}>()), unsigned __int128>);
+      static_assert(std::same_as<decltype(machine::FastestIntegralType<machine::SIGNED, 64>()), __int128>);
+      static_assert(std::same_as<decltype(machine::SmallestIntegralType<0, 65>()), unsigned __int128>);
+      static_assert(std::same_as<Q32_32::IntegralType, int64_t>);
+      static_assert(std::same_as<machine::ProductOf<Q32_32, Q32_32>::IntegralType, __int128>);
+    };
+  };
+
+  given("Q32.32 products of 126 bits") = [&]
+  {
+    auto const lhs = RandomValues<Q32_32>(1000);
+    auto const rhs = RandomValues<Q32_32>(1000);
+
+    then("they should be exact") = [&]
+    {
+      static_assert(machine::ProductOf<Q32_32, Q32_32>::Traits.bits == 126 && machine::ProductOf<Q32_32, Q32_32>::Traits.power == -64);
+
+      std::size_t mismatches = 0;
+      for (std::size_t i = 0 ; i < lhs.size() ; ++i) mismatches += (lhs[i] * rhs[i]).data != static_cast<__int128>(lhs[i].data) * rhs[i].data;
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("products beyond 128 bits") = [&]
+  {
+    then("they should be rounded from their 256-bit magnitude") = [&]
+    {
+      static_assert(machine::ProductOf<UQ64_64, UQ32_32>::Traits.power == -32);
+      static_assert(machine::ProductOf<Q63_64, Q31_32>::Traits.bits == 127 && machine::ProductOf<Q63_64, Q31_32>::Traits.power == -33);
+
+      std::size_t mismatches = 0;
+
+      for (int i = 0 ; i < 1000 ; ++i) {
+        // Truncated: floor(x y / 2^64), from the 64-bit halves of x
+        unsigned __int128 const x = Wide(128);
+        uint64_t const y = Random();
+        unsigned __int128 const truncated = (x >> 64) * y + ((static_cast<unsigned __int128>(static_cast<uint64_t>(x)) * y) >> 64);
+
+        mismatches += (UQ64_64(x) * UQ32_32(y)).data != truncated;
+
+        // Rounded to nearest: |s| |t| / 2^63, ties away from zero, then signed
+        unsigned __int128 const s = Wide(127);
+        uint64_t const t = Random() >> 1;
+        unsigned __int128 const low = static_cast<unsigned __int128>(static_cast<uint64_t>(s)) * t;
+        unsigned __int128 const nearest = 2 * (s >> 64) * t + (low >> 63) + ((low >> 62) & 1);
+        bool const negative = (Random() & 1) != 0;
+
+        auto const product = Q63_64(negative ? -static_cast<__int128>(s) : static_cast<__int128>(s)) * Q31_32(static_cast<int64_t>(t));
+        mismatches += product.data != (negative ? -static_cast<__int128>(nearest) : static_cast<__int128>(nearest));
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+  };
+
+  given("128-bit data") = [&]
+  {
+    using Integer = FixedPrecision<{.isSigned = true, .bits = 127, .power = 0, .maxBits = 127}>;
+    using Saturating = FixedPrecision<{.isSigned = true, .bits = 127, .power = -64, .maxBits = 127, .overflow = machine::OverflowPolicy::Saturate}>;
+
+    __int128 const five = static_cast<__int128>(5) << 64;
+
+    then("it should convert to and from floating point") = [&]
+    {
+      ut::expect(UQ64_64::FromFloat(3.5).data == static_cast<unsigned __int128>(7) << 63);
+      ut::expect(static_cast<double>(UQ64_64(static_cast<unsigned __int128>(3) << 63)) == 1.5);
+      ut::expect(Q63_64::FromFloat(-0x1p62).data == -(static_cast<__int128>(1) << 126));
+      ut::expect(static_cast<double>(Q63_64(-(static_cast<__int128>(3) << 125))) == -0x1.8p62);
+    };
+
+    then("it should compare exactly across powers, and saturate") = [&]
+    {
+      ut::expect(Q63_64(five) == Integer(5));
+      ut::expect(Q63_64(five + 1) > Integer(5));
+      ut::expect(Q63_64(five - 1) < Integer(5));
+      ut::expect(Q63_64(-five - 1) < Integer(-5));
+      ut::expect(Q63_64(-five) == Integer(-5));
+
+      Saturating sum(Saturating::MaxData);
+      sum += Saturating(1);
+      ut::expect(sum.data == Saturating::MaxData);
+    };
+
+    then("Q32.32 quotients should be held in 127 bits") = [&]
+    {
+      auto const quotient = Q32_32::FromFloat(6.0) / Q32_32::FromFloat(1.5);
+
+      static_assert(decltype(quotient)::Traits.bits == 127);
+      ut::expect(quotient == Q32_32::FromFloat(4.0));
+    };
+
+    then("it should compare exactly with the MinData of a much finer operand") = [&]
+    {
+      using Q100_0 = FixedPrecision<{.isSigned = true, .bits = 100, .power = 0, .maxBits = 127}>;
+      using Q63_200 = FixedPrecision<{.isSigned = true, .bits = 63, .power = -200}>;
+      using Q127_200 = FixedPrecision<{.isSigned = true, .bits = 127, .power = -200, .maxBits = 127}>;
+
+      ut::expect(Q100_0(-1) < Q63_200(Q63_200::MinData));
+      ut::expect(Q100_0(-1) < Q127_200(Q127_200::MinData));
+      ut::expect(Q100_0(0) > Q127_200(Q127_200::MinData));
+      ut::expect(Q100_0(0) < Q127_200(1));
+      ut::expect(Q100_0(0) == Q127_200(0));
+      ut::expect(Q127_200(Q127_200::MaxData) < Q100_0(1));
+    };
+  };
+
+  given("sums and differences of 127 and 128-bit data") = [&]
+  {
+    then("they should be rounded from their exact value, carry and all") = [&]
+    {
+      static_assert(decltype(UQ64_64() + UQ64_64())::Traits.bits == 128 && decltype(UQ64_64() + UQ64_64())::Traits.power == -63);
+      static_assert(decltype(Q63_64() + Q63_64())::Traits.bits == 127 && decltype(Q63_64() + Q63_64())::Traits.power == -63);
+      static_assert(decltype(UQ64_64() - UQ64_64())::Traits.isSigned && decltype(UQ64_64() - UQ64_64())::Traits.bits == 127);
+
+      std::size_t mismatches = 0;
+
+      for (int i = 0 ; i < 1000 ; ++i) {
+        // Truncated: the 129-bit sum, halved
+        unsigned __int128 const x = Wide(128), y = Wide(128);
+        unsigned __int128 const sum = x + y;
+        bool const carry = sum < x;
+
+        mismatches += (UQ64_64(x) + UQ64_64(y)).data != ((sum >> 1) | static_cast<unsigned __int128>(carry) << 127);
+
+        // The 129-bit difference, halved (exactly, for a difference of an even value)
+        unsigned __int128 const even = x & ~static_cast<unsigned __int128>(1);
+        __int128 const halved = x >= y ? static_cast<__int128>((even - (y & ~static_cast<unsigned __int128>(1))) >> 1)
+                                       : -static_cast<__int128>(((y & ~static_cast<unsigned __int128>(1)) - even) >> 1);
+        mismatches += (UQ64_64(even) - UQ64_64(y & ~static_cast<unsigned __int128>(1))).data != halved;
+
+        // Rounded to nearest, ties away from zero: s + t = 2 (a + b) + r
+        bool const sNegative = (Random() & 1) != 0, tNegative = (Random() & 1) != 0;
+        __int128 const s = sNegative ? -static_cast<__int128>(Wide(127)) : static_cast<__int128>(Wide(127));
+        __int128 const t = tNegative ? -static_cast<__int128>(Wide(127)) : static_cast<__int128>(Wide(127));
+        __int128 const half = (s >> 1) + (t >> 1);
+        int const r = static_cast<int>(s & 1) + static_cast<int>(t & 1);
+
+        mismatches += (Q63_64(s) + Q63_64(t)).data != half + (r == 2) + (r == 1 && half >= 0);
+      }
+
+      ut::expect(mismatches == 0U);
+    };
+
+    then("signed results of a maxBits of 128 should be held in 127 bits") = [&]
+    {
+      using Q50_50 = FixedPrecision<{.isSigned = true, .bits = 100, .power = -50, .maxBits = 128}>;
+
+      static_assert(machine::ProductOf<Q50_50, Q50_50>::Traits.bits == 127);
+      static_assert(decltype(Q50_50() / Q50_50())::Traits.bits == 127);
+
+      ut::expect(Q50_50::FromFloat(3.0) * Q50_50::FromFloat(-2.5) == Q50_50::FromFloat(-7.5));
+      ut::expect(Q50_50::FromFloat(-7.5) / Q50_50::FromFloat(2.5) == Q50_50::FromFloat(-3.0));
+      ut::expect(UQ64_64::FromFloat(1.25) - UQ64_64::FromFloat(3.5) == Q50_50::FromFloat(-2.25));
+    };
+  };
+
+  given("elementary functions of 128-bit data") = [&]
+  {
+    using UQ50_50 = FixedPrecision<{.isSigned = false, .bits = 100, .power = -50, .maxBits = 128}>;
+
+    then("Log2 and Sqrt should use all of its bits") = [&]
+    {
+      ut::expect(machine::Log2(UQ50_50::FromFloat(0x1p20)) == machine::FixedPrecision<machine::LogarithmTraits>::FromFloat(20.0));
+      ut::expect(machine::Log2(UQ50_50::FromFloat(0x1p-40)) == machine::FixedPrecision<machine::LogarithmTraits>::FromFloat(-40.0));
+      ut::expect(machine::Sqrt(UQ50_50::FromFloat(0x1p20)) == UQ50_50::FromFloat(1024.0));
+      ut::expect(machine::Sqrt(UQ50_50::FromFloat(2.25)) == UQ50_50::FromFloat(1.5));
+    };
+  };
+}
+
+int main()
+{
+  testFixedPrecisionArrays();
+  testFloatConversion();
+  testDivisionByConstant();
+  testAdditionAndComparison();
+  testRoundingAndOverflowPolicies();
+  testElementaryFunctions();
+  testLinearKernels();
+  testFusedExpressions();
+  testWideIntegrals();
+
+  return 0;
+}
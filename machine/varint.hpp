@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Variable length integral encodings, to complement the fixed width encodings of endian.hpp
+//
+// - LEB128 (a.k.a. protobuf varint): 7 data bits per byte, least significant group first,
+//   with the top bit of each byte set when another byte follows.
+// - SLEB128: as LEB128, but sign extended from the final group (DWARF style).
+// - ZigZag: maps signed integrals onto unsigned ones so small magnitudes stay short: 0, -1, 1, -2, ... => 0, 1, 2, 3, ...
+//
+// The bulk LEB128 decoder classifies 16 bytes at a time with a single movemask of the continuation bits.
+// A block of 16 single byte values is widened directly; otherwise each terminated value in the block is
+// gathered with pext (BMI2) when available, in the style of masked-VByte, and the block advances past the last terminator.
+
+namespace culyun::varint {
+
+// Maximum encoded length of a [bits] wide integral
+template <typename Integral>
+constexpr std::size_t MaxLength = (CHAR_BIT * sizeof(Integral) + 6) / 7;
+
+///////////////////////////////////////////////////////////////////////////////
+// ZigZag
+
+template <std::signed_integral Integral>
+constexpr std::make_unsigned_t<Integral> ZigZagEncode(Integral const value)
+{
+  using Unsigned = std::make_unsigned_t<Integral>;
+  return (static_cast<Unsigned>(value) << 1) ^ static_cast<Unsigned>(value >> (CHAR_BIT * sizeof(Integral) - 1));
+}
+
+template <std::unsigned_integral Unsigned>
+constexpr std::make_signed_t<Unsigned> ZigZagDecode(Unsigned const value)
+{
+  return static_cast<std::make_signed_t<Unsigned>>((value >> 1) ^ (Unsigned(0) - (value & 1)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// LEB128 scalar encode / decode
+
+// Encodes value at output, which must have room for MaxLength<Unsigned> bytes.
+// Returns the number of bytes written.
+
+template <std::unsigned_integral Unsigned>
+std::size_t EncodeLeb128(Unsigned value, std::byte * const output)
+{
+  std::size_t length = 0;
+
+  while (value >= 0x80) {
+    output[length++] = static_cast<std::byte>(value | 0x80);
+    value >>= 7;
+  }
+
+  output[length++] = static_cast<std::byte>(value);
+  return length;
+}
+
+template <std::signed_integral Signed>
+std::size_t EncodeSleb128(Signed value, std::byte * const output)
+{
+  std::size_t length = 0;
+
+  for (;;) {
+    auto const group = static_cast<uint8_t>(value & 0x7F);
+    value >>= 7; // Arithmetic shift
+
+    bool const done = (value == 0 && (group & 0x40) == 0) || (value == -1 && (group & 0x40) != 0);
+
+    output[length++] = static_cast<std::byte>(done ? group : group | 0x80);
+
+    if (done) return length;
+  }
+}
+
+// Decodes a single value from input.
+// returns:
+//  (a) the number of bytes consumed if successful, or
+//  (b) 0 if the encoding is truncated, longer than MaxLength<Unsigned>, or overflows Unsigned (or Signed)
+
+template <std::unsigned_integral Unsigned>
+std::size_t DecodeLeb128(std::span<std::byte const> const input, Unsigned & value)
+{
+  constexpr std::size_t Bits = CHAR_BIT * sizeof(Unsigned);
+
+  Unsigned result = 0;
+  std::size_t const limit = std::min(input.size(), MaxLength<Unsigned>);
+
+  for (std::size_t i = 0 ; i < limit ; ++i) {
+    auto const byte = std::to_integer<uint8_t>(input[i]);
+    std::size_t const shift = 7 * i;
+    Unsigned const group = byte & 0x7F;
+
+    // The final group of a maximal length encoding may only hold the remaining bits
+    if (shift + 7 > Bits && (group >> (Bits - shift)) != 0) return 0;
+
+    result |= group << shift;
+
+    if ((byte & 0x80) == 0) {
+      value = result;
+      return i + 1;
+    }
+  }
+
+  return 0;
+}
+
+template <std::signed_integral Signed>
+std::size_t DecodeSleb128(std::span<std::byte const> const input, Signed & value)
+{
+  using Unsigned = std::make_unsigned_t<Signed>;
+  constexpr std::size_t Bits = CHAR_BIT * sizeof(Signed);
+
+  Unsigned result = 0;
+  std::size_t const limit = std::min(input.size(), MaxLength<Signed>);
+
+  for (std::size_t i = 0 ; i < limit ; ++i) {
+    auto const byte = std::to_integer<uint8_t>(input[i]);
+    std::size_t const shift = 7 * i;
+
+    result |= static_cast<Unsigned>(byte & 0x7F) << shift;
+
+    if ((byte & 0x80) == 0) {
+      // The final group of a maximal length encoding may only hold the remaining bits, sign extended
+      if (shift + 7 > Bits) {
+        std::size_t const extension = Bits - shift - 1;
+        uint8_t const high = (byte & 0x7F) >> extension;
+
+        if (high != 0 && high != (0x7F >> extension)) return 0;
+      }
+
+      if (shift + 7 < Bits && (byte & 0x40) != 0) {
+        result |= ~Unsigned(0) << (shift + 7); // Sign extend
+      }
+
+      value = static_cast<Signed>(result);
+      return i + 1;
+    }
+  }
+
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// LEB128 bulk decode
+
+struct BulkDecodeResult
+{
+  std::size_t values = 0; // Number of values written to the output
+  std::size_t bytes = 0;  // Number of input bytes consumed by those values
+};
+
+namespace detail {
+
+// Gathers the 7-bit groups of a [length] byte (length <= 8) encoding held little-endian in word
+
+inline uint64_t GatherGroups(uint64_t const word, unsigned const length)
+{
+  uint64_t const mask = length >= 8 ? ~uint64_t(0) : (uint64_t(1) << (CHAR_BIT * length)) - 1;
+
+#if defined(__BMI2__)
+  return _pext_u64(word & mask, 0x7F7F7F7F7F7F7F7FULL);
+#else
+  uint64_t const groups = word & mask & 0x7F7F7F7F7F7F7F7FULL;
+  uint64_t result = 0;
+
+  for (unsigned i = 0 ; i < length ; ++i) {
+    result |= ((groups >> (CHAR_BIT * i)) & 0x7F) << (7 * i);
+  }
+
+  return result;
+#endif
+}
+
+} // namespace detail
+
+// Decodes consecutive values from input until output is full, input is exhausted,
+// or a malformed / truncated value is reached (compare the result's bytes with input.size()).
+
+template <std::unsigned_integral Unsigned>
+BulkDecodeResult DecodeLeb128(std::span<std::byte const> const input, std::span<Unsigned> const output)
+{
+  std::size_t in = 0;
+  std::size_t out = 0;
+
+  auto const scalarStep = [&]() {
+    std::size_t const length = DecodeLeb128(input.subspan(in), output[out]);
+    if (length == 0) return false;
+    in += length;
+    ++out;
+    return true;
+  };
+
+#if defined(__SSE2__)
+  while (in + 16 <= input.size() && out + 16 <= output.size()) {
+    __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input.data() + in));
+    auto const continuations = static_cast<uint32_t>(_mm_movemask_epi8(block));
+
+    if (continuations == 0) {
+      // Fast path: sixteen single byte values
+
+      alignas(16) uint8_t bytes[16];
+      _mm_store_si128(reinterpret_cast<__m128i *>(bytes), block);
+
+      for (unsigned i = 0 ; i < 16 ; ++i) {
+        output[out + i] = bytes[i];
+      }
+
+      in += 16;
+      out += 16;
+      continue;
+    }
+
+    if (continuations == 0xFFFF) {
+      // No terminator in the block; a long (or malformed) value
+      if (!scalarStep()) break;
+      continue;
+    }
+
+    // Decode each value terminated within the block.
+    // The block is copied to a padded buffer so every value can be loaded as a whole word.
+
+    alignas(16) uint8_t bytes[16 + 8] = {};
+    _mm_store_si128(reinterpret_cast<__m128i *>(bytes), block);
+
+    uint32_t terminators = ~continuations & 0xFFFF;
+    unsigned start = 0;
+    bool malformed = false;
+
+    while (terminators != 0) {
+      unsigned const end = static_cast<unsigned>(std::countr_zero(terminators));
+      unsigned const length = end - start + 1;
+
+      if (length > 8 || length > MaxLength<Unsigned>) {
+        // Rare: values needing more than 56 bits of groups, or possible overflow; decode exactly
+        std::size_t const consumed = DecodeLeb128(input.subspan(in + start), output[out]);
+        if (consumed == 0) { malformed = true; break; }
+      } else {
+        uint64_t word;
+        std::memcpy(&word, bytes + start, sizeof(word));
+
+        if constexpr (std::endian::native == std::endian::big) {
+          word = __builtin_bswap64(word);
+        }
+
+        uint64_t const value = detail::GatherGroups(word, length);
+
+        if (value > std::numeric_limits<Unsigned>::max()) { malformed = true; break; }
+
+        output[out] = static_cast<Unsigned>(value);
+      }
+
+      ++out;
+      start = end + 1;
+      terminators &= terminators - 1;
+    }
+
+    in += start;
+
+    if (malformed) break;
+  }
+#endif
+
+  while (in < input.size() && out < output.size()) {
+    if (!scalarStep()) break;
+  }
+
+  return {out, in};
+}
+
+}
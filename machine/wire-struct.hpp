@@ -0,0 +1,267 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "endian.hpp"
+
+// WireStruct describes the wire encoding of a native struct once, as an ordered list of member pointers:
+//
+//   struct Header { uint16_t type; uint32_t length; uint64_t sequence; };
+//   using HeaderWire = endian::WireStruct<std::endian::big, &Header::type, &Header::length, &Header::sequence>;
+//
+// From that list the field offsets and sizes, and the total wire size, are calculated at build time.
+// Encode / Decode are fully unrolled (one load / swap / store per field), and collapse to a single memcpy
+// when the wire order is native and the native struct already has the wire layout.
+// HeaderWire::View gives zero-copy access to individual fields of an encoded message in place.
+
+namespace culyun { namespace endian {
+
+template<typename FieldType>
+concept WireFieldType =
+    ((std::is_integral_v<FieldType> || std::is_enum_v<FieldType>) &&
+     (sizeof(FieldType) == 1 || sizeof(FieldType) == 2 || sizeof(FieldType) == 4 || sizeof(FieldType) == 8)) ||
+    Integral128<FieldType>;
+
+namespace detail {
+
+template <typename MemberPointer>
+struct MemberPointerTraits;
+
+template <typename Class, typename Member>
+struct MemberPointerTraits<Member Class::*>
+{
+  using ClassType = Class;
+  using MemberType = Member;
+};
+
+// A never-active union member lets us take the addresses of the members of a Class at build time,
+// without requiring Class itself to be constexpr constructible.
+
+template <typename Class>
+union LayoutProbe
+{
+  Class object;
+  char unused;
+
+  constexpr LayoutProbe() : unused(0) {}
+};
+
+template <typename Class>
+inline constexpr LayoutProbe<Class> layoutProbe{};
+
+template <auto lhs, auto rhs>
+constexpr bool SameMember()
+{
+  if constexpr (std::is_same_v<decltype(lhs), decltype(rhs)>) {
+    return lhs == rhs;
+  } else {
+    return false;
+  }
+}
+
+} // namespace detail
+
+template <std::endian order, auto... members>
+requires (sizeof...(members) > 0) && (std::is_member_object_pointer_v<decltype(members)> && ...)
+class WireStruct
+{
+private:
+  template <auto member>
+  using MemberType = typename detail::MemberPointerTraits<decltype(member)>::MemberType;
+
+  template <auto member>
+  using ClassType = typename detail::MemberPointerTraits<decltype(member)>::ClassType;
+
+public:
+  using Native = std::tuple_element_t<0, std::tuple<ClassType<members>...>>;
+
+  static_assert((std::is_same_v<ClassType<members>, Native> && ...),
+                "\n\n\33[1;31mError: All WireStruct members must belong to the same native struct!\33[0m\n\n");
+
+  static_assert((WireFieldType<MemberType<members>> && ...),
+                "\n\n\33[1;31mError: WireStruct members must be 1, 2, 4, 8, or 16 byte integrals or enumerations!\33[0m\n\n");
+
+  static constexpr std::endian Order = order;
+
+  static constexpr std::size_t FieldCount = sizeof...(members);
+
+  static constexpr std::array<std::size_t, FieldCount> Sizes = { sizeof(MemberType<members>)... };
+
+  static constexpr std::array<std::size_t, FieldCount> Offsets = []() {
+    std::array<std::size_t, FieldCount> offsets = {};
+    std::size_t offset = 0;
+
+    for (std::size_t i = 0 ; i < FieldCount ; ++i) {
+      offsets[i] = offset;
+      offset += Sizes[i];
+    }
+
+    return offsets;
+  }();
+
+  static constexpr std::size_t Size = Offsets[FieldCount - 1] + Sizes[FieldCount - 1];
+
+  template <std::size_t index>
+  using FieldType = std::tuple_element_t<index, std::tuple<MemberType<members>...>>;
+
+  // Index of a member pointer within the description, e.g. IndexOf<&Header::length>() == 1
+
+  template <auto member>
+  static constexpr std::size_t IndexOf()
+  {
+    std::size_t index = 0;
+    std::size_t result = FieldCount;
+    ((detail::SameMember<member, members>() ? result = index : result, ++index), ...);
+    return result;
+  }
+
+  // True when the listed members tile Native in declaration order with no padding,
+  // i.e. the native struct is byte for byte the wire layout (apart from byte order).
+
+  static constexpr bool IsNativeLayout = []() {
+    if constexpr (!std::is_trivially_copyable_v<Native> || sizeof(Native) != Size) {
+      return false;
+    } else {
+      void const * const addresses[] = { &(detail::layoutProbe<Native>.object.*members)... };
+
+      for (std::size_t i = 1 ; i < FieldCount ; ++i) {
+        if (!(addresses[i - 1] < addresses[i])) return false;
+      }
+
+      return true;
+    }
+  }();
+
+  static constexpr bool IsVerbatim = IsNativeLayout && order == std::endian::native;
+
+  // Single field access
+
+  template <std::size_t index>
+  static FieldType<index> Load(std::byte const * const wire)
+  {
+    using Field = FieldType<index>;
+    using Raw = detail::UnsignedOfWidth<sizeof(Field)>;
+
+    Raw raw;
+    std::memcpy(&raw, wire + Offsets[index], sizeof(Raw));
+
+    if constexpr (sizeof(Raw) > 1 && order != std::endian::native) {
+      raw = ReverseBytes(raw);
+    }
+
+    return std::bit_cast<Field>(raw);
+  }
+
+  template <std::size_t index>
+  static void Store(std::byte * const wire, FieldType<index> const value)
+  {
+    using Field = FieldType<index>;
+    using Raw = detail::UnsignedOfWidth<sizeof(Field)>;
+
+    Raw raw = std::bit_cast<Raw>(value);
+
+    if constexpr (sizeof(Raw) > 1 && order != std::endian::native) {
+      raw = ReverseBytes(raw);
+    }
+
+    std::memcpy(wire + Offsets[index], &raw, sizeof(Raw));
+  }
+
+  // Whole struct encode / decode
+
+  static void Encode(Native const & native, std::span<std::byte> const wire)
+  {
+    assert(wire.size() >= Size);
+
+    if constexpr (IsVerbatim) {
+      std::memcpy(wire.data(), &native, Size);
+    } else {
+      EncodeFields(native, wire.data(), std::make_index_sequence<FieldCount>{});
+    }
+  }
+
+  static void Decode(std::span<std::byte const> const wire, Native & native)
+  {
+    assert(wire.size() >= Size);
+
+    if constexpr (IsVerbatim) {
+      std::memcpy(&native, wire.data(), Size);
+    } else {
+      DecodeFields(wire.data(), native, std::make_index_sequence<FieldCount>{});
+    }
+  }
+
+  static Native Decode(std::span<std::byte const> const wire)
+  {
+    Native native{};
+    Decode(wire, native);
+    return native;
+  }
+
+  // Zero-copy view of an encoded message.
+  // Byte is std::byte for a mutable view, or std::byte const for a read only view.
+
+  template <typename Byte>
+  requires std::is_same_v<std::remove_const_t<Byte>, std::byte>
+  class View
+  {
+  private:
+    std::span<Byte> wire;
+
+  public:
+    explicit View(std::span<Byte> const wire) : wire(wire) {
+      assert(wire.size() >= Size);
+    }
+
+    template <auto member>
+    MemberType<member> get() const {
+      static_assert(IndexOf<member>() < FieldCount, "\n\n\33[1;31mError: Member is not part of this WireStruct!\33[0m\n\n");
+      return Load<IndexOf<member>()>(wire.data());
+    }
+
+    template <auto member>
+    requires (!std::is_const_v<Byte>)
+    void set(MemberType<member> const value) const {
+      static_assert(IndexOf<member>() < FieldCount, "\n\n\33[1;31mError: Member is not part of this WireStruct!\33[0m\n\n");
+      Store<IndexOf<member>()>(wire.data(), value);
+    }
+
+    Native decode() const { return Decode(wire); }
+
+    void decode(Native & native) const { Decode(wire, native); }
+
+    void encode(Native const & native) const requires (!std::is_const_v<Byte>) { Encode(native, wire); }
+
+    std::span<Byte, Size> bytes() const { return wire.template first<Size>(); }
+  };
+
+  using ConstView = View<std::byte const>;
+  using MutableView = View<std::byte>;
+
+  static ConstView Overlay(std::span<std::byte const> const wire) { return ConstView(wire); }
+  static MutableView Overlay(std::span<std::byte> const wire) { return MutableView(wire); }
+
+private:
+  template <std::size_t... indices>
+  static void EncodeFields(Native const & native, std::byte * const wire, std::index_sequence<indices...>)
+  {
+    (Store<indices>(wire, native.*members), ...);
+  }
+
+  template <std::size_t... indices>
+  static void DecodeFields(std::byte const * const wire, Native & native, std::index_sequence<indices...>)
+  {
+    ((native.*members = Load<indices>(wire)), ...);
+  }
+};
+
+}} // namespace culyun::endian
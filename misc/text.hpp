@@ -1,10 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
 
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
 #include <fmt/core.h>
 #include <fmt/format.h>
 
@@ -18,62 +27,167 @@ std::string concatenate(auto &&... args)
   return result;
 }
 
-template <typename T>
-constexpr std::string_view hexFmtString()
-{
-  // Intended for use with fmt::format / std::format
-  //
-  // The "{}" is a placeholder targeting the vargs supplied to xyz::format
-  // ':' ==> formatting expression follows
-  // '#' ==> use the following alternative representation
-  //     '0' ==> zero pad left
-  //     nn  ==> maximum field width, which is calculated to allow for the '0x' prefix and 2 characters per byte
-  //     'x' ==> format output as lower-case hex digits
-
-  if constexpr (sizeof(T) == 1) {
-    return "{:#04x}";
-  }
+// Buffer oriented hex formatting, for trace logging of packets, with no allocations or format strings.
+//
+// Bytes are converted to lower-case hex digits 32 bytes per iteration with AVX2 (16 with SSSE3): each nibble
+// indexes a 16-entry digit table with pshufb, and the high and low nibble digits are interleaved into place.
 
-  if constexpr (sizeof(T) == 2) {
-    return "{:#06x}";
-  }
+namespace detail {
 
-  if constexpr (sizeof(T) == 4) {
-    return "{:#010x}";
-  }
+constexpr char HexDigits[] = "0123456789abcdef";
 
-  if constexpr (sizeof(T) == 8) {
-    return "{:#018x}";
-  }
+} // namespace detail
 
-  // Non-power of two sizes
+// Writes two hex digits per byte to output, which must have room for 2 * bytes.size() characters.
+// Returns the end of the output.
 
-  if constexpr (sizeof(T) == 3) {
-    return "{:#08x}";
+inline char * toHexInto(char * output, std::span<std::byte const> const bytes)
+{
+  std::byte const * input = bytes.data();
+  std::size_t size = bytes.size();
+
+#if defined(__AVX2__)
+  {
+    __m256i const digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(detail::HexDigits)));
+    __m256i const nibble = _mm256_set1_epi8(0x0F);
+
+    for ( ; size >= 32 ; size -= 32, input += 32, output += 64) {
+      __m256i const value = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(input));
+      __m256i const high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble));
+      __m256i const low = _mm256_shuffle_epi8(digits, _mm256_and_si256(value, nibble));
+
+      // Unpacking interleaves within 128-bit lanes, so the lanes are then put back in order
+      __m256i const first = _mm256_unpacklo_epi8(high, low);
+      __m256i const second = _mm256_unpackhi_epi8(high, low);
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(output), _mm256_permute2x128_si256(first, second, 0x20));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
   }
+#endif
+
+#if defined(__SSSE3__)
+  {
+    __m128i const digits = _mm_loadu_si128(reinterpret_cast<__m128i const *>(detail::HexDigits));
+    __m128i const nibble = _mm_set1_epi8(0x0F);
+
+    for ( ; size >= 16 ; size -= 16, input += 16, output += 32) {
+      __m128i const value = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input));
+      __m128i const high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(value, 4), nibble));
+      __m128i const low = _mm_shuffle_epi8(digits, _mm_and_si128(value, nibble));
 
-  if constexpr (sizeof(T) == 5) {
-    return "{:#012x}";
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_unpacklo_epi8(high, low));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16), _mm_unpackhi_epi8(high, low));
+    }
   }
+#endif
 
-  if constexpr (sizeof(T) == 6) {
-    return "{:#014x}";
+  for ( ; size > 0 ; --size, ++input) {
+    auto const value = std::to_integer<unsigned>(*input);
+    *output++ = detail::HexDigits[value >> 4];
+    *output++ = detail::HexDigits[value & 0x0F];
   }
 
-  if constexpr (sizeof(T) == 7) {
-    return "{:#016x}";
+  return output;
+}
+
+// Writes number as toHex does, i.e. "0x" followed by two digits per byte, to output,
+// which must have room for 2 + 2 * sizeof(Integral) characters.  Returns the end of the output.
+
+template<typename Integral>
+requires std::is_integral_v<Integral>
+char * toHexInto(char * output, Integral const & number)
+{
+  using UIntegral = std::make_unsigned_t<Integral>;
+
+  // Most significant byte first
+  std::byte bytes[sizeof(UIntegral)];
+  for (std::size_t i = 0 ; i < sizeof(UIntegral) ; ++i) {
+    bytes[i] = static_cast<std::byte>(static_cast<UIntegral>(number) >> (CHAR_BIT * (sizeof(UIntegral) - 1 - i)));
   }
 
-  return "{:#0x}";
+  *output++ = '0';
+  *output++ = 'x';
+  return toHexInto(output, std::span<std::byte const>(bytes));
 }
 
 template<typename Integral>
 requires std::is_integral_v<Integral>
 std::string toHex(Integral const & number)
 {
-  using UIntegral = std::make_unsigned_t<Integral>;
-  constexpr auto fmtString = hexFmtString<UIntegral>();
-  return fmt::format(fmtString, static_cast<UIntegral>(number));
+  char buffer[2 + 2 * sizeof(Integral)];
+  return std::string(buffer, toHexInto(buffer, number));
+}
+
+// Classic hexdump (as hexdump -C), 16 bytes per line: an 8 digit offset, the bytes in hex, and the printable bytes.
+//
+//   00000000  47 45 54 20 2f 20 48 54  54 50 2f 31 2e 31 0d 0a  |GET / HTTP/1.1..|
+//
+// HexdumpSize is an upper bound on the characters written for [bytes] bytes; the last line may be shorter.
+
+constexpr std::size_t HexdumpBytesPerLine = 16;
+constexpr std::size_t HexdumpLineLength = 79;
+
+constexpr std::size_t HexdumpSize(std::size_t const bytes)
+{
+  return (bytes + HexdumpBytesPerLine - 1) / HexdumpBytesPerLine * HexdumpLineLength;
+}
+
+// Writes the hexdump of bytes to output, numbering lines from offset.  Returns the end of the output.
+
+inline char * hexdumpInto(char * output, std::span<std::byte const> const bytes, std::size_t const offset = 0)
+{
+  // Columns of a line: the offset, two spaces, 16 x "xx " (with an extra space after the 8th), a space,
+  // then the printable bytes between bars
+  constexpr std::size_t HexColumn = 10;
+  constexpr std::size_t AsciiColumn = 61;
+
+  for (std::size_t line = 0 ; line < bytes.size() ; line += HexdumpBytesPerLine) {
+    std::size_t const count = std::min(HexdumpBytesPerLine, bytes.size() - line);
+    std::span<std::byte const> const chunk = bytes.subspan(line, count);
+
+    std::size_t const address = offset + line;
+    for (std::size_t digit = 0 ; digit < 8 ; ++digit) {
+      output[digit] = detail::HexDigits[(address >> (28 - 4 * digit)) & 0x0F];
+    }
+
+    std::memset(output + 8, ' ', AsciiColumn - 9);
+    output[AsciiColumn - 1] = '|';
+
+    char digits[2 * HexdumpBytesPerLine];
+    toHexInto(digits, chunk);
+
+    for (std::size_t i = 0 ; i < count ; ++i) {
+      std::memcpy(output + HexColumn + 3 * i + (i >= 8 ? 1 : 0), digits + 2 * i, 2);
+
+      auto const character = std::to_integer<unsigned char>(chunk[i]);
+      output[AsciiColumn + i] = character - 0x20U < 0x5FU ? static_cast<char>(character) : '.';
+    }
+
+    output[AsciiColumn + count] = '|';
+    output[AsciiColumn + count + 1] = '\n';
+    output += AsciiColumn + count + 2;
+  }
+
+  return output;
+}
+
+// Appends the hexdump of bytes to a fmt::memory_buffer (or any contiguous, resizable character buffer)
+
+template <typename Buffer>
+void hexdump(Buffer & output, std::span<std::byte const> const bytes, std::size_t const offset = 0)
+{
+  std::size_t const size = output.size();
+  output.resize(size + HexdumpSize(bytes.size()));
+  char * const end = hexdumpInto(output.data() + size, bytes, offset);
+  output.resize(static_cast<std::size_t>(end - output.data()));
+}
+
+inline std::string hexdump(std::span<std::byte const> const bytes, std::size_t const offset = 0)
+{
+  std::string result;
+  hexdump(result, bytes, offset);
+  return result;
 }
 
 }